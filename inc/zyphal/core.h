@@ -2,13 +2,18 @@
 #define ZYPHAL_CORE_H
 
 #include <stdint.h>
+#include <zephyr/drivers/can.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/mpsc_lockfree.h>
+#include <zephyr/sys/rb.h>
 #include <zephyr/sys/slist.h>
 
 #define ZYPHAL_MAX_NODE_ID (127)
 #define ZYPHAL_MAX_SERVICE_ID (511)
 #define ZYPHAL_MAX_SUBJECT_ID (8191)
+/* Source node ID reported for anonymous transfers. */
+#define ZYPHAL_NODE_ID_UNSET (255)
 
 typedef enum {
     ZYPHAL_PRIO_EXCEPTIONAL = 0,
@@ -23,52 +28,542 @@ typedef enum {
 
 typedef void (*zyphal_tx_done_cb_t)(void* user_data, int32_t status);
 
+/* When a transfer sent over redundant interfaces completes. */
+typedef enum {
+    /* Once sent on every interface, failing if any interface fails. */
+    ZYPHAL_TX_POLICY_ALL = 0,
+    /* Once sent on any interface, the transfer is dropped from the slower interfaces.
+     * Fails only if every interface fails. */
+    ZYPHAL_TX_POLICY_FIRST = 1,
+} zyphal_tx_policy_t;
+
+/* Payload fragment, published fragments are serialized back to back. */
+typedef struct {
+    const uint8_t* data;
+    size_t len;
+} zyphal_iov_t;
+
+/* Fetches the len payload bytes from offset into buf, just before the frame carrying
+ * them is sent. Returns len, or a negative error failing the transfer. Called from the
+ * transmit work with the instance locked, for every interface and again for a frame the
+ * driver rejected, so it must return the same bytes every time and should not block for
+ * long. */
+typedef int32_t (*zyphal_tx_source_cb_t)(void* user_data,
+                                         size_t offset,
+                                         uint8_t* buf,
+                                         size_t len);
+
+/* Metadata and payload of a received transfer. */
+typedef struct {
+    zyphal_prio_t priority;
+    uint16_t port_id;
+    /* ZYPHAL_NODE_ID_UNSET for anonymous transfers. */
+    uint8_t source_node_id;
+    uint8_t transfer_id;
+    /* Uptime in ticks at which the first frame of the transfer was received. */
+    int64_t timestamp;
+    /* Only valid for the duration of the receive callback. */
+    const uint8_t* payload;
+    size_t payload_len;
+} zyphal_rx_transfer_t;
+
+/* Called from the receive work of the instance once a full transfer has been received.
+ * Without CONFIG_ZYPHAL_RX_WORKQ it shares the work queue of the transmitter, so it must
+ * not wait for a transfer to be sent. */
+typedef void (*zyphal_rx_cb_t)(const zyphal_rx_transfer_t* transfer, void* user_data);
+
+/* Called once the response to a request has been received, with a status of zero. If the
+ * request fails, times out (-ETIMEDOUT) or is canceled (-ECANCELED), response is NULL
+ * and status is negative. */
+typedef void (*zyphal_response_cb_t)(const zyphal_rx_transfer_t* response,
+                                     int32_t status,
+                                     void* user_data);
+
 /* TODO: Define members in private header. */
 typedef struct {
-    /* CAN bus device used for communication. */
-    const struct device* canbus;
-    /* 7-Bit cyphal node ID. */
-    uint8_t node_id;
-    /* Provides thread-safe access to instances. */
-    struct k_mutex mutex;
-    /* Transmission data queue and work item. */
-    sys_slist_t tx_queue;
-    struct k_work_delayable tx_work;
-} zyphal_inst_t;
+    /* Reassembly buffer, and total number of transfer bytes received (including CRC). */
+    uint8_t payload[CONFIG_ZYPHAL_RX_EXTENT_MAX];
+    size_t received;
+    /* Uptime in ticks of the first frame of the current or last transfer. */
+    int64_t timestamp;
+    uint16_t crc;
+    uint8_t transfer_id : 5;
+    /* Toggle bit expected on the next frame. */
+    uint8_t toggle : 1;
+    /* A multi-frame transfer is in progress. */
+    uint8_t active : 1;
+    /* Redundant interface the session accepts transfers from, duplicates arriving on
+     * the other interfaces are dropped. */
+    uint8_t iface : 2;
+    /* Owning subscription and remote node, or next free index while in the pool. */
+    struct zyphal_sub* owner;
+    uint8_t source;
+    uint8_t next_free;
+} zyphal_rx_session_t;
+
+/* Hardware acceptance filter slot, shared by one or more subscriptions. */
+typedef struct {
+    struct can_filter filter;
+    /* CAN driver filter ID on each interface. */
+    int filter_id[CONFIG_ZYPHAL_IFACE_MAX];
+    /* Number of subscriptions accepted through this slot, zero if unused. */
+    uint16_t members;
+} zyphal_rx_filter_t;
+
+/* Filter slot as installed on one interface, handed to the CAN driver as the filter
+ * user data. */
+typedef struct {
+    struct zyphal_iface* iface;
+    uint8_t slot;
+} zyphal_rx_filter_ref_t;
+
+/* Frame handed to the CAN driver, from send until the completion has been reaped. */
+typedef struct {
+    struct zyphal_iface* iface;
+    /* Transfer the frame belongs to, NULL if it was completed while the frame was in
+     * flight. */
+    struct zyphal_tx* tx;
+    bool busy;
+    /* Status reported by the CAN driver on completion. */
+    int status;
+} zyphal_tx_slot_t;
 
 /* TODO: Define members in private header. */
 typedef struct {
+    /* Owning transfer, and interface priority queue node. */
+    struct zyphal_tx* tx;
+    struct rbnode node;
+    bool queued;
+    /* A frame of this transfer is held by a transmit slot of the interface. */
+    bool in_flight;
+    /* Sent on the interface, or dropped from it. */
+    bool done;
+    /* Index of the next frame, and cursor of its first payload byte. */
+    uint8_t toggle : 1;
+    uint8_t crc_written : 2;
+    size_t frame;
+    size_t iov_index;
+    size_t iov_offset;
+    size_t payload_written;
+#if defined(CONFIG_ZYPHAL_TX_ADMISSION)
+    /* Bus time of the frames still to send, counted in the interface backlog. */
+    uint32_t backlog_us;
+#endif
+} zyphal_tx_cursor_t;
+
+/* TODO: Define members in private header. */
+typedef struct zyphal_tx {
     /* Owning instance. */
-    zyphal_inst_t* inst;
-    /* Transmit priority queue node. */
-    sys_snode_t node;
+    struct zyphal_inst* inst;
+    /* Publish handoff node, and push order among equal CAN IDs. */
+    struct mpsc_node handoff_node;
+    uint32_t seq;
+    /* Progress of the transfer on each interface. */
+    zyphal_tx_cursor_t cursors[CONFIG_ZYPHAL_IFACE_MAX];
     /* Extended CAN ID, used to determine priority. */
     uint32_t id;
-    /* Time after which the transmission is discarded. */
+    /* Time after which the transmission is discarded, and its place in the deadline
+     * index. */
     k_timepoint_t end;
-    /* Payload data, length, and amount written. */
-    uint8_t* payload;
+    struct rbnode deadline_node;
+    bool deadline_queued;
+    /* Payload fragments, total length and number of frames. A single fragment is stored
+     * in payload_iov. With a payload source, frames fetch their payload from it
+     * instead. */
+    const zyphal_iov_t* iov;
+    zyphal_iov_t payload_iov;
+    zyphal_tx_source_cb_t source;
+    void* source_user_data;
     size_t payload_len;
-    size_t payload_written;
-    /* Cyphal transfer tail byte contents, and crc. */
-    uint8_t toggle : 1;
+    size_t frames;
+    /* Cyphal transfer ID, and crc over the frames built so far by the leading interface,
+     * so the payload is only run through the crc once. */
     uint8_t transfer_id : 5;
-    uint8_t crc_written : 2;
     uint16_t crc;
-    /* Number of frames pending transmit. */
+    size_t crc_frames;
+#if defined(CONFIG_ZYPHAL_TX_STATS)
+    /* Uptime in ticks at publish, for the latency statistics. */
+    int64_t start_ticks;
+#endif
+    /* Number of interfaces still sending, and the first error among them. */
     atomic_t pending;
+    int32_t status;
+    /* Optional storage for the frames of the last transfer, the CAN ID and number of
+     * frames cached, and whether the current transfer replays them. */
+    struct can_frame* cache;
+    size_t cache_size;
+    uint32_t cache_id;
+    size_t cache_frames;
+    bool cache_hit;
     /* Called once full message has been transmitted. */
     zyphal_tx_done_cb_t done_cb;
     void* done_user_data;
 } zyphal_tx_t;
 
-/* Initializes a zyphal instance. */
+/* TODO: Define members in private header. */
+typedef struct {
+    /* Transmitter of the pool, and the payload block it owns until the transfer
+     * completes. */
+    zyphal_tx_t tx;
+    uint8_t block_class;
+    uint8_t block;
+    /* Called once the transfer completes, after both have been released. */
+    zyphal_tx_done_cb_t cb;
+    void* user_data;
+} zyphal_tx_pooled_t;
+
+/* Payload block size classes of the transfer pool, small, medium and large. */
+#define ZYPHAL_TX_POOL_CLASSES (3)
+
+/* Transfer pool usage, in use now and the most in use at once since the instance was
+ * initialized. */
+typedef struct {
+    uint32_t transfers_used;
+    uint32_t transfers_max;
+    uint32_t blocks_used[ZYPHAL_TX_POOL_CLASSES];
+    uint32_t blocks_max[ZYPHAL_TX_POOL_CLASSES];
+    /* Publishes refused because no transmitter or fitting payload block was free. */
+    uint32_t exhausted;
+} zyphal_tx_pool_stats_t;
+
+/* Message of a publish batch, and the result of publishing it. */
+typedef struct {
+    zyphal_tx_t* tx;
+    zyphal_prio_t priority;
+    uint16_t subject_id;
+    uint8_t* payload;
+    size_t len;
+    k_timeout_t timeout;
+    int32_t status;
+} zyphal_publish_entry_t;
+
+/* TODO: Define members in private header. */
+typedef struct {
+    /* Transfers of the batch still pending, plus one while the batch is being
+     * published, and the first error among the completed ones. */
+    atomic_t remaining;
+    atomic_t status;
+    /* Called once every published transfer of the batch has completed. */
+    zyphal_tx_done_cb_t cb;
+    void* user_data;
+} zyphal_publish_batch_t;
+
+/* Transfer ID state of a transmit session. */
+typedef struct {
+    /* CAN ID of the session transfers without priority and source node, zero if the
+     * entry is unused. */
+    uint32_t key;
+    uint8_t next_transfer_id;
+} zyphal_tx_session_t;
+
+/* Transmit counters, accumulated since the instance was initialized. Rates such as
+ * frames per second follow from the difference between two snapshots. */
+typedef struct {
+    /* Transfers published, and how they completed. */
+    uint32_t published;
+    uint32_t completed;
+    uint32_t failed;
+    uint32_t expired;
+    uint32_t canceled;
+    /* Transfers published but not yet completed, and the most seen at once. */
+    uint32_t depth;
+    uint32_t depth_max;
+    /* Frames handed to the CAN driver, and their data bytes including tail byte, CRC
+     * and padding, summed over every interface. */
+    uint32_t frames;
+    uint64_t bytes;
+#if defined(CONFIG_ZYPHAL_TX_STATS)
+    /* Time from publish to completion of successful transfers in microseconds, at the
+     * resolution of the system tick. Bucket i counts times below 2^(i+1), the last
+     * bucket also counts all longer times. */
+    uint32_t latency_us[CONFIG_ZYPHAL_TX_STATS_LATENCY_BUCKETS];
+    uint32_t latency_max_us;
+#endif
+    /* Frames refused by the CAN driver because every controller mailbox was full. */
+    uint32_t mailbox_full;
+    /* Mailboxes full without any frame of this instance in flight, so the transmitter
+     * retried after CONFIG_ZYPHAL_TX_BUSY_RETRY_US instead of on a completion. */
+    uint32_t busy_retries;
+    /* Ready transfers waited because every in-flight slot was busy. */
+    uint32_t slots_full;
+    /* The transmitter had to wait for the instance mutex. */
+    uint32_t lock_waits;
+} zyphal_tx_stats_t;
+
+/* Receive counters, accumulated since the instance was initialized. */
+typedef struct {
+    /* Frames taken from the receive rings by the receive work, summed over every
+     * interface. */
+    uint32_t frames;
+    /* Frames dropped because the receive ring of their interface was full. */
+    uint32_t ring_overflows;
+    /* Most frames found waiting in a receive ring by the receive work. */
+    uint32_t ring_max;
+} zyphal_rx_stats_t;
+
+/* TODO: Define members in private header. */
+typedef struct zyphal_iface {
+    /* Owning instance, and index among its interfaces. */
+    struct zyphal_inst* inst;
+    uint8_t index;
+    /* CAN bus device of the interface. */
+    const struct device* canbus;
+    /* Transmission priority queue, a tree per priority level with a bitmap of non-empty
+     * levels. Each interface sends at its own pace. */
+    struct rbtree tx_queue[ZYPHAL_PRIO_OPTIONAL + 1];
+    uint8_t tx_queue_levels;
+    /* Frames currently in flight, and the slots completed by the CAN driver. */
+    zyphal_tx_slot_t tx_slots[CONFIG_ZYPHAL_TX_INFLIGHT_MAX];
+    ATOMIC_DEFINE(tx_slots_done, CONFIG_ZYPHAL_TX_INFLIGHT_MAX);
+#if defined(CONFIG_ZYPHAL_TX_ADMISSION)
+    /* Bit times of the bus, zero if unknown, and bus time in microseconds still needed
+     * by the queued frames of each priority level. */
+    uint32_t tx_bit_ns;
+    uint32_t tx_data_bit_ns;
+    uint32_t tx_backlog_us[ZYPHAL_PRIO_OPTIONAL + 1];
+#endif
+    /* Filter slots as installed on this interface. */
+    zyphal_rx_filter_ref_t rx_filter_refs[CONFIG_ZYPHAL_RX_FILTER_SLOTS];
+    /* Frames received by the CAN driver callback, and the filter slot that passed each,
+     * waiting for the receive work. Head and tail count the frames pushed and popped,
+     * only the callback moves the head and only the work the tail. */
+    struct can_frame rx_ring[CONFIG_ZYPHAL_RX_RING_DEPTH];
+    uint8_t rx_ring_slots[CONFIG_ZYPHAL_RX_RING_DEPTH];
+    atomic_t rx_ring_head;
+    atomic_t rx_ring_tail;
+    atomic_t rx_ring_overflows;
+} zyphal_iface_t;
+
+/* TODO: Define members in private header. */
+typedef struct zyphal_inst {
+    /* Redundant CAN interfaces used for communication, the first given on init. */
+    zyphal_iface_t ifaces[CONFIG_ZYPHAL_IFACE_MAX];
+    uint8_t iface_count;
+    /* 7-Bit cyphal node ID. */
+    uint8_t node_id;
+    /* Provides thread-safe access to instances. */
+    struct k_mutex mutex;
+    /* Set by the first zyphal_init, which starts the work queues of the instance. */
+    uint32_t initialized;
+    /* Push order of transfers, shared by the interface queues, and the transmit work
+     * item serving every interface. */
+    uint32_t tx_queue_seq;
+    /* Transfers published but not yet moved into the priority queues. */
+    struct mpsc tx_handoff;
+    struct k_work_delayable tx_work;
+    /* Queued transfers with a deadline ordered by it, the earliest deadline the expiry
+     * work is scheduled for, and the work completing the transfers that pass it. */
+    struct rbtree tx_deadlines;
+    k_timepoint_t tx_expiry_next;
+    struct k_work_delayable tx_expiry_work;
+#if defined(CONFIG_ZYPHAL_TX_WORKQ)
+    /* Dedicated queue the transmit work runs on, instead of the system work queue. */
+    struct k_work_q tx_workq;
+    K_KERNEL_STACK_MEMBER(tx_workq_stack, CONFIG_ZYPHAL_TX_WORKQ_STACK_SIZE);
+#endif
+    zyphal_tx_policy_t tx_policy;
+    /* Transmit sessions used so far, open addressed by their key. */
+    struct k_spinlock tx_session_lock;
+    zyphal_tx_session_t tx_sessions[CONFIG_ZYPHAL_TX_SESSION_TABLE_SIZE];
+    size_t tx_session_count;
+#if defined(CONFIG_ZYPHAL_TX_STATS)
+    zyphal_tx_stats_t tx_stats;
+#endif
+#if defined(CONFIG_ZYPHAL_TX_POOL)
+    /* Transmitters and payload blocks of zyphal_publish_copy, bitmaps of the free ones,
+     * and their usage. */
+    struct k_spinlock tx_pool_lock;
+    zyphal_tx_pooled_t tx_pool[CONFIG_ZYPHAL_TX_POOL_TRANSFERS];
+    uint32_t tx_pool_free;
+    uint8_t tx_pool_small[CONFIG_ZYPHAL_TX_POOL_SMALL_COUNT]
+                         [CONFIG_ZYPHAL_TX_POOL_SMALL_SIZE];
+    uint8_t tx_pool_medium[CONFIG_ZYPHAL_TX_POOL_MEDIUM_COUNT]
+                          [CONFIG_ZYPHAL_TX_POOL_MEDIUM_SIZE];
+    uint8_t tx_pool_large[CONFIG_ZYPHAL_TX_POOL_LARGE_COUNT]
+                         [CONFIG_ZYPHAL_TX_POOL_LARGE_SIZE];
+    uint32_t tx_pool_blocks_free[ZYPHAL_TX_POOL_CLASSES];
+    zyphal_tx_pool_stats_t tx_pool_stats;
+#endif
+    /* Active subscriptions, and open addressed lookup table by port. */
+    sys_slist_t rx_subs;
+    struct zyphal_sub* rx_ports[CONFIG_ZYPHAL_RX_PORT_TABLE_SIZE];
+    /* Planned hardware acceptance filters, and the number of slots that may be used. */
+    zyphal_rx_filter_t rx_filters[CONFIG_ZYPHAL_RX_FILTER_SLOTS];
+    size_t rx_filter_budget;
+    /* Statically sized pool of receive sessions, shared by all subscriptions. */
+    struct k_spinlock rx_lock;
+    zyphal_rx_session_t rx_sessions[CONFIG_ZYPHAL_RX_SESSIONS];
+    uint8_t rx_free;
+    /* Work reassembling and dispatching the frames of the receive rings, and its
+     * counters. */
+    struct k_work rx_work;
+    zyphal_rx_stats_t rx_stats;
+#if defined(CONFIG_ZYPHAL_RX_WORKQ)
+    /* Dedicated queue the receive work runs on, instead of the transmit work queue. */
+    struct k_work_q rx_workq;
+    K_KERNEL_STACK_MEMBER(rx_workq_stack, CONFIG_ZYPHAL_RX_WORKQ_STACK_SIZE);
+#endif
+    /* Outstanding requests, open addressed by (service, server, transfer ID), and the
+     * work completing requests that pass their deadline. */
+    struct k_spinlock rpc_lock;
+    struct zyphal_request* rpc_pending[CONFIG_ZYPHAL_RPC_PENDING_TABLE_SIZE];
+    size_t rpc_pending_count;
+    k_timepoint_t rpc_next_deadline;
+    struct k_work_delayable rpc_work;
+#if defined(CONFIG_ZYPHAL_PERIODIC)
+    /* Periodic publishers hashed by release slot, the next slot to visit, and the work
+     * visiting them. */
+    sys_slist_t periodic_wheel[CONFIG_ZYPHAL_PERIODIC_WHEEL_SIZE];
+    size_t periodic_count;
+    int64_t periodic_pos;
+    struct k_work_delayable periodic_work;
+#endif
+} zyphal_inst_t;
+
+/* TODO: Define members in private header. */
+typedef struct zyphal_sub {
+    /* Owning instance. */
+    zyphal_inst_t* inst;
+    /* Instance subscription list node. */
+    sys_snode_t node;
+    /* Subscribed subject or service ID, its lookup key including the transfer kind, and
+     * maximum stored payload size. */
+    uint16_t port_id;
+    uint16_t port_key;
+    size_t extent;
+    /* Exact acceptance filter for this port, and the planned filter slot it uses. */
+    struct can_filter filter;
+    uint8_t filter_slot;
+    /* Index into the instance session pool for each source node ID, O(1) lookup. */
+    uint8_t sessions[ZYPHAL_MAX_NODE_ID + 1];
+    /* Called once a full transfer has been received. */
+    zyphal_rx_cb_t cb;
+    void* user_data;
+} zyphal_sub_t;
+
+#if defined(CONFIG_ZYPHAL_TRACING)
+/* Transmit tracing hooks provided by the application, for example forwarding to a CTF
+ * tracing backend. Publish may be called from an ISR, the others are called from the
+ * transmit work with the instance mutex held. */
+void zyphal_trace_tx_publish(const zyphal_tx_t* tx);
+void zyphal_trace_tx_enqueue(const zyphal_iface_t* iface, const zyphal_tx_t* tx);
+void zyphal_trace_tx_frame(const zyphal_iface_t* iface,
+                           const zyphal_tx_t* tx,
+                           const struct can_frame* frame);
+void zyphal_trace_tx_done(const zyphal_tx_t* tx, int32_t status);
+#endif
+
+/* Builds the payload of a periodic message into the buffer of the given size, returning
+ * its length, or a negative value to skip this period. */
+typedef int32_t (*zyphal_periodic_cb_t)(uint8_t* payload, size_t size, void* user_data);
+
+/* Periodic publisher counters, accumulated since the publisher was started. */
+typedef struct {
+    uint32_t published;
+    /* Periods without a message sent before the deadline, because the release was late,
+     * the previous message was still being sent, or the transfer timed out. */
+    uint32_t missed;
+    /* Delay of the latest release after its scheduled time, and the largest delay seen,
+     * in ticks. */
+    uint32_t jitter_last;
+    uint32_t jitter_max;
+} zyphal_periodic_stats_t;
+
+/* TODO: Define members in private header. */
+typedef struct zyphal_periodic {
+    /* Transmitter of the message, and the buffer its payload is built in. */
+    zyphal_tx_t tx;
+    uint8_t* buffer;
+    size_t size;
+    /* Timer wheel node, and the next release, period and deadline in ticks. */
+    sys_snode_t node;
+    int64_t release;
+    int64_t period;
+    int64_t deadline;
+    zyphal_prio_t priority;
+    uint16_t subject_id;
+    /* Called at every release to build the payload. */
+    zyphal_periodic_cb_t cb;
+    void* user_data;
+    zyphal_periodic_stats_t stats;
+} zyphal_periodic_t;
+
+#if defined(CONFIG_ZYPHAL_CRC_CUSTOM)
+/* Transfer CRC backend provided by the application, for example using an MCU CRC
+ * peripheral. Must update crc with data as CRC-16/CCITT-FALSE (polynomial 0x1021, no
+ * reflection, no final XOR), and may be called from the CAN receive context. */
+uint16_t zyphal_crc16_custom(uint16_t crc, const uint8_t* data, size_t len);
+#endif
+
+/* TODO: Define members in private header. */
+typedef struct zyphal_client {
+    /* Response subscription of the service. */
+    zyphal_sub_t sub;
+    /* Next transfer ID of requests whose session does not fit the instance table. */
+    uint8_t transfer_id;
+} zyphal_client_t;
+
+/* TODO: Define members in private header. */
+typedef struct zyphal_request {
+    /* Client the request is sent through, and its transmitter. */
+    zyphal_client_t* client;
+    zyphal_tx_t tx;
+    /* Pending table key, together with the client service ID. */
+    uint8_t server_node_id;
+    uint8_t transfer_id;
+    /* Waiting for a response, which must arrive before the deadline. */
+    bool pending;
+    k_timepoint_t deadline;
+    /* Links requests being completed outside of the pending table lock. */
+    sys_snode_t node;
+    /* Called once the request completes. */
+    zyphal_response_cb_t cb;
+    void* user_data;
+} zyphal_request_t;
+
+/* Initializes a zyphal instance. The instance must be zeroed before it is first
+ * initialized, as static instances are, and may be initialized again afterwards, which
+ * keeps its work queues running. Returns -EINVAL for an instance that is neither. */
 int32_t zyphal_init(zyphal_inst_t* inst, const struct device* canbus, uint8_t node_id);
+/* Adds a redundant CAN interface. Every transfer is then sent on all interfaces, and
+ * received once from whichever interface delivers it. Must be called before publishing
+ * or subscribing. */
+int32_t zyphal_iface_add(zyphal_inst_t* inst, const struct device* canbus);
+/* Sets when transfers sent over redundant interfaces complete, ZYPHAL_TX_POLICY_ALL by
+ * default. */
+int32_t zyphal_tx_policy_set(zyphal_inst_t* inst, zyphal_tx_policy_t policy);
+/* Sets the nominal and data phase bitrates of an interface, a data bitrate of zero
+ * meaning the nominal one. Publishing at or below CONFIG_ZYPHAL_TX_ADMISSION_PRIO then
+ * returns -EBUSY if the queued frames ahead leave no time to send the transfer before
+ * its timeout. A bitrate of zero admits every transfer. -ENOTSUP without
+ * CONFIG_ZYPHAL_TX_ADMISSION. */
+#if defined(CONFIG_ZYPHAL_TX_ADMISSION)
+int32_t zyphal_iface_bitrate_set(zyphal_inst_t* inst,
+                                 uint8_t index,
+                                 uint32_t bitrate,
+                                 uint32_t bitrate_data);
+#else
+static inline int32_t zyphal_iface_bitrate_set(zyphal_inst_t* inst,
+                                               uint8_t index,
+                                               uint32_t bitrate,
+                                               uint32_t bitrate_data) {
+    return -ENOTSUP;
+}
+#endif
 
-/* Initializes a transmitter object. */
+/* Initializes a transmitter object. Transfer IDs belong to the session, so transmitters
+ * of the same subject continue each other's sequence. */
 int32_t zyphal_tx_init(zyphal_inst_t* inst, zyphal_tx_t* tx);
 
-/* Publishes a message. */
+/* Caches the frames built for each transfer in the given storage of count frames. A
+ * following transfer with the same CAN ID and an identical payload replays the cached
+ * frames, only patching the transfer ID, instead of building them again. Transfers
+ * needing more frames than count are not cached. Passing NULL disables the cache. */
+int32_t zyphal_tx_cache_set(zyphal_tx_t* tx, struct can_frame* frames, size_t count);
+
+/* Publishes a message. Does not block, and may be called from an ISR. A transfer not
+ * sent within the timeout completes with -ETIMEDOUT at its deadline, even while queued
+ * behind higher priority transfers. */
 int32_t zyphal_publish(zyphal_tx_t* tx,
                        zyphal_prio_t priority,
                        uint16_t subject_id,
@@ -77,6 +572,77 @@ int32_t zyphal_publish(zyphal_tx_t* tx,
                        k_timeout_t timeout,
                        zyphal_tx_done_cb_t cb,
                        void* user_data);
+/* Publishes a message built from consecutive payload fragments, without copying them
+ * into a contiguous buffer. Fragment data, and the fragment array if it has more than
+ * one element, must remain valid until the transfer completes. */
+int32_t zyphal_publish_v(zyphal_tx_t* tx,
+                         zyphal_prio_t priority,
+                         uint16_t subject_id,
+                         const zyphal_iov_t* iov,
+                         size_t iov_count,
+                         k_timeout_t timeout,
+                         zyphal_tx_done_cb_t cb,
+                         void* user_data);
+/* Publishes a message of len bytes fetched from source as the frames are sent, so the
+ * payload need not be held in memory. The source must be able to provide the payload
+ * until the transfer completes. The payload is never matched against the frame cache,
+ * the frames sent are still cached for zyphal_republish. */
+int32_t zyphal_publish_source(zyphal_tx_t* tx,
+                              zyphal_prio_t priority,
+                              uint16_t subject_id,
+                              size_t len,
+                              zyphal_tx_source_cb_t source,
+                              void* source_user_data,
+                              k_timeout_t timeout,
+                              zyphal_tx_done_cb_t cb,
+                              void* user_data);
+/* Publishes the message of every entry with its transmitter of the instance, waking
+ * the transmit work once for all of them. If any entry is invalid, its status is set to
+ * -EINVAL, that of the others to -ECANCELED, and nothing is published. Otherwise the
+ * status of each entry is set as by zyphal_publish, and the number of messages
+ * published is returned. If any was, cb is called once all of them have completed, with
+ * the first error among them, possibly before this returns. batch holds the completion
+ * state until then, and may be NULL without cb. Does not block, and may be called from
+ * an ISR. */
+int32_t zyphal_publish_batch(zyphal_inst_t* inst,
+                             zyphal_publish_entry_t* entries,
+                             size_t count,
+                             zyphal_publish_batch_t* batch,
+                             zyphal_tx_done_cb_t cb,
+                             void* user_data);
+/* Publishes a copy of the payload with a transmitter of the instance pool, so neither
+ * the payload nor a transmitter needs to outlive this call. The transfer is sent with
+ * the next transfer ID of the subject session. cb is optional. Returns -EMSGSIZE if the
+ * payload exceeds the largest pool block, or -ENOMEM if the pool is exhausted. Does not
+ * block, and may be called from an ISR. -ENOTSUP without CONFIG_ZYPHAL_TX_POOL. */
+#if defined(CONFIG_ZYPHAL_TX_POOL)
+int32_t zyphal_publish_copy(zyphal_inst_t* inst,
+                            zyphal_prio_t priority,
+                            uint16_t subject_id,
+                            const uint8_t* payload,
+                            size_t len,
+                            k_timeout_t timeout,
+                            zyphal_tx_done_cb_t cb,
+                            void* user_data);
+#else
+static inline int32_t zyphal_publish_copy(zyphal_inst_t* inst,
+                                          zyphal_prio_t priority,
+                                          uint16_t subject_id,
+                                          const uint8_t* payload,
+                                          size_t len,
+                                          k_timeout_t timeout,
+                                          zyphal_tx_done_cb_t cb,
+                                          void* user_data) {
+    return -ENOTSUP;
+}
+#endif
+/* Publishes the message of the previous transfer again, with the next transfer ID, from
+ * the frame cache. Returns -ENOENT if the cache does not hold the previous transfer. Does
+ * not block, and may be called from an ISR. */
+int32_t zyphal_republish(zyphal_tx_t* tx,
+                         k_timeout_t timeout,
+                         zyphal_tx_done_cb_t cb,
+                         void* user_data);
 /* Publishes a message, returning once the message has been sent. */
 int32_t zyphal_publish_wait(zyphal_tx_t* tx,
                             zyphal_prio_t priority,
@@ -87,7 +653,135 @@ int32_t zyphal_publish_wait(zyphal_tx_t* tx,
 
 /* Returns true if a transmission is currently pending. */
 bool zyphal_tx_pending(zyphal_tx_t* tx);
-/* Cancels a currently pending transmission. */
+/* Cancels a currently pending transmission, must not be called from an ISR. */
 int32_t zyphal_tx_cancel(zyphal_tx_t* tx);
+/* Copies the transmit counters of an instance, -ENOTSUP without
+ * CONFIG_ZYPHAL_TX_STATS. */
+int32_t zyphal_tx_stats_get(zyphal_inst_t* inst, zyphal_tx_stats_t* stats);
+
+/* Copies the transfer pool usage of an instance, -ENOTSUP without
+ * CONFIG_ZYPHAL_TX_POOL. */
+#if defined(CONFIG_ZYPHAL_TX_POOL)
+int32_t zyphal_tx_pool_stats_get(zyphal_inst_t* inst, zyphal_tx_pool_stats_t* stats);
+#else
+static inline int32_t zyphal_tx_pool_stats_get(zyphal_inst_t* inst,
+                                               zyphal_tx_pool_stats_t* stats) {
+    return -ENOTSUP;
+}
+#endif
+
+/* Starts publishing a message once every period, built by cb into buffer from the
+ * transmit work queue. Each message must be sent within deadline of its scheduled
+ * release, or the period is counted as missed. The first release is placed where it
+ * collides with the fewest other publishers of the instance. Returns -EALREADY if the
+ * publisher is running already. These return -ENOTSUP without CONFIG_ZYPHAL_PERIODIC. */
+#if defined(CONFIG_ZYPHAL_PERIODIC)
+int32_t zyphal_periodic_start(zyphal_inst_t* inst,
+                              zyphal_periodic_t* per,
+                              zyphal_prio_t priority,
+                              uint16_t subject_id,
+                              k_timeout_t period,
+                              k_timeout_t deadline,
+                              uint8_t* buffer,
+                              size_t size,
+                              zyphal_periodic_cb_t cb,
+                              void* user_data);
+/* Stops a periodic publisher, canceling a message still being sent. */
+int32_t zyphal_periodic_stop(zyphal_periodic_t* per);
+/* Copies the counters of a periodic publisher. */
+int32_t zyphal_periodic_stats_get(zyphal_periodic_t* per,
+                                  zyphal_periodic_stats_t* stats);
+#else
+static inline int32_t zyphal_periodic_start(zyphal_inst_t* inst,
+                                            zyphal_periodic_t* per,
+                                            zyphal_prio_t priority,
+                                            uint16_t subject_id,
+                                            k_timeout_t period,
+                                            k_timeout_t deadline,
+                                            uint8_t* buffer,
+                                            size_t size,
+                                            zyphal_periodic_cb_t cb,
+                                            void* user_data) {
+    return -ENOTSUP;
+}
+static inline int32_t zyphal_periodic_stop(zyphal_periodic_t* per) {
+    return -ENOTSUP;
+}
+static inline int32_t zyphal_periodic_stats_get(zyphal_periodic_t* per,
+                                                zyphal_periodic_stats_t* stats) {
+    return -ENOTSUP;
+}
+#endif
+
+/* Subscribes to a message subject, payloads larger than extent are truncated. */
+int32_t zyphal_subscribe(zyphal_inst_t* inst,
+                         zyphal_sub_t* sub,
+                         uint16_t subject_id,
+                         size_t extent,
+                         zyphal_rx_cb_t cb,
+                         void* user_data);
+/* Removes a subscription, the callback will not be called once this returns. Waits
+ * for a callback running on the receive work queue, unless called from that work queue.
+ * Must not be called from an ISR. */
+int32_t zyphal_unsubscribe(zyphal_sub_t* sub);
+/* Copies the receive counters of an instance. */
+int32_t zyphal_rx_stats_get(zyphal_inst_t* inst, zyphal_rx_stats_t* stats);
+
+/* Serves requests of a service addressed to this node, removed with zyphal_unsubscribe.
+ * Responses are sent with zyphal_respond, using the source node and transfer ID of the
+ * request. */
+int32_t zyphal_serve(zyphal_inst_t* inst,
+                     zyphal_sub_t* sub,
+                     uint16_t service_id,
+                     size_t extent,
+                     zyphal_rx_cb_t cb,
+                     void* user_data);
+/* Responds to a received request. May be called from the receive callback. */
+int32_t zyphal_respond(zyphal_tx_t* tx,
+                       zyphal_prio_t priority,
+                       uint16_t service_id,
+                       uint8_t client_node_id,
+                       uint8_t transfer_id,
+                       uint8_t* payload,
+                       size_t len,
+                       k_timeout_t timeout,
+                       zyphal_tx_done_cb_t cb,
+                       void* user_data);
+/* Responds to a received request with a payload of len bytes fetched from source, as
+ * zyphal_publish_source. */
+int32_t zyphal_respond_source(zyphal_tx_t* tx,
+                              zyphal_prio_t priority,
+                              uint16_t service_id,
+                              uint8_t client_node_id,
+                              uint8_t transfer_id,
+                              size_t len,
+                              zyphal_tx_source_cb_t source,
+                              void* source_user_data,
+                              k_timeout_t timeout,
+                              zyphal_tx_done_cb_t cb,
+                              void* user_data);
+
+/* Initializes a client of a service, receiving responses of up to extent bytes. */
+int32_t zyphal_client_init(zyphal_inst_t* inst,
+                           zyphal_client_t* client,
+                           uint16_t service_id,
+                           size_t extent);
+/* Stops a client, outstanding requests complete with -ECANCELED. */
+int32_t zyphal_client_deinit(zyphal_client_t* client);
+/* Initializes a request object, each outstanding request needs its own. */
+int32_t zyphal_request_init(zyphal_client_t* client, zyphal_request_t* req);
+/* Sends a request to a server node. The callback is called once with the response, or
+ * with an error if no response arrives within the timeout. Up to 32 requests may be
+ * outstanding to the same server through a client. */
+int32_t zyphal_request(zyphal_request_t* req,
+                       zyphal_prio_t priority,
+                       uint8_t server_node_id,
+                       uint8_t* payload,
+                       size_t len,
+                       k_timeout_t timeout,
+                       zyphal_response_cb_t cb,
+                       void* user_data);
+/* Cancels an outstanding request, must not be called from an ISR. */
+int32_t zyphal_request_cancel(zyphal_request_t* req);
 
 #endif /* ZYPHAL_CORE_H */
@@ -0,0 +1,261 @@
+#ifndef ZYPHAL_DSDL_H
+#define ZYPHAL_DSDL_H
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+/* Support for the serializers generated by scripts/gen_dsdl.py. Values are bit packed
+ * least significant bit first, as DSDL requires. */
+
+/* Writes the serialized image of an object, of which only the bytes in [start, end) are
+ * stored, at buf. Objects serialize into a chunk by writing the image from its start,
+ * skipping the fields before the chunk and stopping after it. */
+typedef struct {
+    uint8_t* buf;
+    size_t start;
+    size_t end;
+    /* Bit offset of the next field in the image. */
+    size_t bit;
+    int32_t err;
+} zyphal_dsdl_writer_t;
+
+/* Writer storing nothing, the offset it ends at gives the size of the image. */
+#define ZYPHAL_DSDL_MEASURE                                                              \
+    ((zyphal_dsdl_writer_t){.start = SIZE_MAX / 8, .end = SIZE_MAX / 8})
+
+typedef struct {
+    const uint8_t* buf;
+    size_t size;
+    size_t bit;
+} zyphal_dsdl_reader_t;
+
+static inline zyphal_dsdl_writer_t zyphal_dsdl_writer(uint8_t* buf,
+                                                      size_t offset,
+                                                      size_t size) {
+    return (zyphal_dsdl_writer_t){.buf = buf, .start = offset, .end = offset + size};
+}
+
+/* True once nothing further can land in the window, or the object is invalid. A field
+ * ending right at the window end is followed by one more, so an image longer than the
+ * window always ends past it. */
+static inline bool zyphal_dsdl_writer_done(const zyphal_dsdl_writer_t* w) {
+    return w->err != 0 || w->bit > w->end * 8;
+}
+
+/* Skips the units of bits wholly before the window, of count in a row, returning the
+ * number skipped. */
+static inline size_t zyphal_dsdl_writer_skip(zyphal_dsdl_writer_t* w,
+                                             size_t bits,
+                                             size_t count) {
+    if (bits == 0 || w->bit >= w->start * 8) { return 0; }
+
+    size_t n = MIN((w->start * 8 - w->bit) / bits, count);
+    w->bit += n * bits;
+    return n;
+}
+
+static inline void zyphal_dsdl_set_u64(uint8_t* buf,
+                                       size_t bit,
+                                       uint64_t value,
+                                       uint8_t bits) {
+    while (bits > 0) {
+        uint8_t shift = bit % 8;
+        uint8_t n = MIN(8 - shift, bits);
+        uint8_t mask = (uint8_t)(((1U << n) - 1) << shift);
+        buf[bit / 8] = (buf[bit / 8] & ~mask) | ((uint8_t)(value << shift) & mask);
+        value >>= n;
+        bit += n;
+        bits -= n;
+    }
+}
+
+static inline uint64_t zyphal_dsdl_get_u64(const uint8_t* buf, size_t bit, uint8_t bits) {
+    uint64_t value = 0;
+    uint8_t read = 0;
+    while (read < bits) {
+        uint8_t shift = bit % 8;
+        uint8_t n = MIN(8 - shift, bits - read);
+        value |= (uint64_t)((buf[bit / 8] >> shift) & ((1U << n) - 1)) << read;
+        bit += n;
+        read += n;
+    }
+    return value;
+}
+
+static inline void zyphal_dsdl_write_u64(zyphal_dsdl_writer_t* w,
+                                         uint64_t value,
+                                         uint8_t bits) {
+    while (bits > 0) {
+        size_t byte = w->bit / 8;
+        uint8_t shift = w->bit % 8;
+        uint8_t n = MIN(8 - shift, bits);
+        if (byte >= w->start && byte < w->end) {
+            zyphal_dsdl_set_u64(&w->buf[byte - w->start], shift, value, n);
+        }
+        value >>= n;
+        w->bit += n;
+        bits -= n;
+    }
+}
+
+static inline void zyphal_dsdl_write_bytes(zyphal_dsdl_writer_t* w,
+                                           const uint8_t* data,
+                                           size_t len) {
+    if (w->bit % 8 != 0) {
+        for (size_t i = 0; i < len && !zyphal_dsdl_writer_done(w); i++) {
+            zyphal_dsdl_write_u64(w, data[i], 8);
+        }
+        return;
+    }
+
+    /* Aligned bytes are copied in one go, clipped to the window. */
+    size_t first = MAX(w->bit / 8, w->start);
+    size_t last = MIN(w->bit / 8 + len, w->end);
+    if (first < last) {
+        memcpy(&w->buf[first - w->start], &data[first - w->bit / 8], last - first);
+    }
+    w->bit += len * 8;
+}
+
+/* Pads with zero bits to the next byte boundary. */
+static inline void zyphal_dsdl_write_align(zyphal_dsdl_writer_t* w) {
+    zyphal_dsdl_write_u64(w, 0, (8 - w->bit % 8) % 8);
+}
+
+/* Reads bits past the end of the buffer as zero, as DSDL requires. */
+static inline uint64_t zyphal_dsdl_read_u64(zyphal_dsdl_reader_t* r, uint8_t bits) {
+    uint64_t value = 0;
+    if (r->bit + bits <= r->size * 8) {
+        value = zyphal_dsdl_get_u64(r->buf, r->bit, bits);
+    } else if (r->bit < r->size * 8) {
+        value = zyphal_dsdl_get_u64(r->buf, r->bit, r->size * 8 - r->bit);
+    }
+    r->bit += bits;
+    return value;
+}
+
+static inline void zyphal_dsdl_read_bytes(zyphal_dsdl_reader_t* r,
+                                          uint8_t* data,
+                                          size_t len) {
+    if (r->bit % 8 != 0) {
+        for (size_t i = 0; i < len; i++) { data[i] = zyphal_dsdl_read_u64(r, 8); }
+        return;
+    }
+
+    size_t avail = r->bit / 8 < r->size ? MIN(r->size - r->bit / 8, len) : 0;
+    if (avail > 0) { memcpy(data, &r->buf[r->bit / 8], avail); }
+    if (avail < len) { memset(&data[avail], 0, len - avail); }
+    r->bit += len * 8;
+}
+
+static inline void zyphal_dsdl_read_align(zyphal_dsdl_reader_t* r) {
+    r->bit = ROUND_UP(r->bit, 8);
+}
+
+/* Reads the delimiter header of a nested object, setting sub to read the object and
+ * moving past it. Returns false if the object exceeds the buffer. */
+static inline bool zyphal_dsdl_read_delimited(zyphal_dsdl_reader_t* r,
+                                              zyphal_dsdl_reader_t* sub) {
+    size_t len = zyphal_dsdl_read_u64(r, 32);
+    size_t byte = r->bit / 8;
+    if (byte > r->size || len > r->size - byte) { return false; }
+
+    *sub = (zyphal_dsdl_reader_t){.buf = &r->buf[byte], .size = len};
+    r->bit += len * 8;
+    return true;
+}
+
+static inline uint64_t zyphal_dsdl_sat_u(uint64_t value, uint8_t bits) {
+    uint64_t max = bits < 64 ? (UINT64_C(1) << bits) - 1 : UINT64_MAX;
+    return MIN(value, max);
+}
+
+static inline int64_t zyphal_dsdl_sat_i(int64_t value, uint8_t bits) {
+    int64_t max = (int64_t)((UINT64_C(1) << (bits - 1)) - 1);
+    return value > max ? max : (value < -max - 1 ? -max - 1 : value);
+}
+
+static inline int64_t zyphal_dsdl_sign_extend(uint64_t value, uint8_t bits) {
+    uint64_t sign = UINT64_C(1) << (bits - 1);
+    return (int64_t)((value ^ sign) - sign);
+}
+
+static inline uint32_t zyphal_dsdl_f32_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline float zyphal_dsdl_f32_from_bits(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline uint64_t zyphal_dsdl_f64_bits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline double zyphal_dsdl_f64_from_bits(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* Rounds to the nearest half precision value. Finite values out of range become the
+ * largest finite value of their sign when saturated, infinite otherwise. */
+static inline uint16_t zyphal_dsdl_f16_bits(float value, bool saturate) {
+    uint32_t in = zyphal_dsdl_f32_bits(value);
+    uint16_t sign = (in >> 16) & 0x8000;
+    uint32_t abs = in & 0x7FFFFFFF;
+
+    if (abs >= 0x7F800000) { return sign | 0x7C00 | (abs > 0x7F800000 ? 0x200 : 0); }
+    if (abs >= 0x477FF000) { return sign | (saturate ? 0x7BFF : 0x7C00); }
+    if (abs < 0x33000000) { return sign; }
+    if (abs < 0x38800000) {
+        /* Subnormal in half precision. */
+        uint32_t shift = 126 - (abs >> 23);
+        uint32_t mant = (abs & 0x7FFFFF) | 0x800000;
+        uint32_t half = mant >> shift;
+        uint32_t rem = mant & ((1U << shift) - 1);
+        if (rem > (1U << (shift - 1)) || (rem == (1U << (shift - 1)) && (half & 1))) {
+            half++;
+        }
+        return sign | half;
+    }
+
+    uint32_t half = (abs >> 13) - ((127 - 15) << 10);
+    uint32_t rem = abs & 0x1FFF;
+    if (rem > 0x1000 || (rem == 0x1000 && (half & 1))) { half++; }
+    return sign | half;
+}
+
+static inline float zyphal_dsdl_f16_from_bits(uint16_t half) {
+    uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+    uint32_t exp = (half >> 10) & 0x1F;
+    uint32_t mant = half & 0x3FF;
+
+    if (exp == 0x1F) {
+        /* Infinity or NaN. */
+        return zyphal_dsdl_f32_from_bits(sign | 0x7F800000 | (mant << 13));
+    }
+    if (exp == 0) {
+        if (mant == 0) { return zyphal_dsdl_f32_from_bits(sign); }
+        /* Subnormal in half precision, normal in single precision. */
+        exp = 113;
+        while ((mant & 0x400) == 0) {
+            mant <<= 1;
+            exp--;
+        }
+        return zyphal_dsdl_f32_from_bits(sign | (exp << 23) | ((mant & 0x3FF) << 13));
+    }
+    return zyphal_dsdl_f32_from_bits(sign | ((exp + 112) << 23) | (mant << 13));
+}
+
+#endif /* ZYPHAL_DSDL_H */
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Compares the benchmark output of two runs, reporting regressed metrics.
+
+Usage: bench_compare.py baseline.txt current.txt [--threshold PERCENT]
+
+Rows are the comma separated lines following a header line starting with "suite", keyed
+by their configuration columns. Metrics in "per s" are better when higher, all others
+when lower. Exits with status 1 if any metric regressed by more than the threshold.
+"""
+
+import argparse
+import sys
+
+# Columns naming the configuration of a row rather than a result.
+KEY_COLUMNS = ("suite", "can", "nodes", "payload bytes", "transmitters", "completion us")
+
+
+def parse(path):
+    rows = {}
+    header = None
+    with open(path) as f:
+        for line in f:
+            fields = [field.strip() for field in line.split(",")]
+            if fields[0] == "suite":
+                header = fields
+                continue
+            if header is None or len(fields) != len(header):
+                continue
+
+            row = dict(zip(header, fields))
+            try:
+                metrics = {c: int(v) for c, v in row.items() if c not in KEY_COLUMNS}
+            except ValueError:
+                continue
+            key = tuple(row[c] for c in header if c in KEY_COLUMNS)
+            rows[key] = metrics
+    return rows
+
+
+def regression(metric, base, cur):
+    """Returns the relative regression of a metric, positive if it got worse."""
+    if base == 0:
+        return 0.0
+    change = (cur - base) / base
+    return -change if "per s" in metric else change
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0)
+    args = parser.parse_args()
+
+    baseline = parse(args.baseline)
+    current = parse(args.current)
+
+    regressed = 0
+    for key, metrics in sorted(current.items()):
+        if key not in baseline:
+            continue
+        for metric, cur in metrics.items():
+            base = baseline[key].get(metric)
+            if base is None:
+                continue
+            change = regression(metric, base, cur) * 100
+            if change > args.threshold:
+                regressed += 1
+                print(f"{', '.join(key)}: {metric} {base} -> {cur} ({change:+.1f}%)")
+
+    print(f"{regressed} regressed metrics over {args.threshold}%")
+    return 1 if regressed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""Generates the slice-by-N lookup tables used by src/crc.c.
+
+Usage: gen_crc_tables.py > src/crc_tables.h
+"""
+
+POLY = 0x1021
+SLICES = 8
+
+
+def byte_table():
+    table = []
+    for i in range(256):
+        crc = i << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ POLY) if crc & 0x8000 else (crc << 1)
+        table.append(crc & 0xFFFF)
+    return table
+
+
+def slice_tables():
+    tables = [byte_table()]
+    for _ in range(1, SLICES):
+        prev = tables[-1]
+        tables.append([((c << 8) & 0xFFFF) ^ tables[0][c >> 8] for c in prev])
+    return tables
+
+
+def main():
+    tables = slice_tables()
+    print("/* Generated by scripts/gen_crc_tables.py, do not edit. */")
+    print("#ifndef CRC_TABLES_H")
+    print("#define CRC_TABLES_H")
+    print()
+    print("#include <stdint.h>")
+    print()
+    print("/* CRC-16/CCITT-FALSE lookup tables, table k advances the CRC over a byte followed")
+    print(" * by k zero bytes. Only the tables needed for the configured slice count are")
+    print(" * compiled in. */")
+    print("static const uint16_t crc_tables[CONFIG_ZYPHAL_CRC_TABLE_SLICES][256] = {")
+    for k, table in enumerate(tables):
+        guard = k > 0
+        if guard:
+            print(f"#if CONFIG_ZYPHAL_CRC_TABLE_SLICES > {k}")
+        print("    {")
+        for row in range(0, 256, 8):
+            entries = ", ".join(f"0x{v:04X}" for v in table[row : row + 8])
+            print(f"        {entries},")
+        print("    },")
+        if guard:
+            print("#endif")
+    print("};")
+    print()
+    print("#endif /* CRC_TABLES_H */")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,912 @@
+#!/usr/bin/env python3
+"""Generates C serializers for DSDL data types, one header per definition file.
+
+Usage: gen_dsdl.py --output DIR NAMESPACE_DIR...
+
+Each NAMESPACE_DIR is a root namespace named after the directory, nested namespaces are
+its subdirectories. A definition [PORT.]Name.MAJOR.MINOR.dsdl in namespace a.b becomes
+DIR/a/b/Name_MAJOR_MINOR.h, declaring the type a_b_Name_MAJOR_MINOR, or the types
+a_b_Name_Request_MAJOR_MINOR and a_b_Name_Response_MAJOR_MINOR for a service. For every
+type T the header defines:
+
+    T_EXTENT_BYTES, T_MAX_SIZE_BYTES   buffer bounds, computed here
+    T_serialize(obj, buf, size)        whole object into buf
+    T_serialize_chunk(obj, off, ...)   bytes [off, off + size) of the serialized object
+    T_serialized_size(obj)             serialized length in bytes
+    T_deserialize(obj, buf, size)      whole object from buf
+    T_publish(tx, ..., obj, ...)       message sent as zyphal_publish_source
+    T_respond(tx, ..., obj, ...)       service response sent as zyphal_respond_source
+
+Types of fixed layout, made of primitives, padding and fixed arrays and sealed types of
+fixed layout themselves, are packed at constant offsets. All others go through the bit
+writer of zyphal/dsdl.h, which also serves chunks without an intermediate buffer. The
+publish and respond functions use chunks as the payload source, so each frame is
+serialized just before it is sent.
+
+Supported are primitive, void, array and composite fields, constants, services, and the
+@sealed, @extent and @union directives. @assert, @print and @deprecated are ignored.
+"""
+
+import argparse
+import ast
+import fractions
+import operator
+import os
+import re
+import sys
+
+
+class DsdlError(Exception):
+    pass
+
+
+class Primitive:
+    def __init__(self, kind, bits, saturated):
+        self.kind = kind
+        self.bits = bits
+        self.saturated = saturated
+
+    def ctype(self):
+        if self.kind == "bool":
+            return "bool"
+        if self.kind == "float":
+            return "double" if self.bits == 64 else "float"
+        width = next(w for w in (8, 16, 32, 64) if w >= self.bits)
+        return f"{'u' if self.kind == 'uint' else ''}int{width}_t"
+
+    def is_byte(self):
+        return self.kind in ("uint", "int") and self.bits == 8
+
+
+class Void:
+    def __init__(self, bits):
+        self.bits = bits
+
+
+class Array:
+    def __init__(self, element, capacity, variable):
+        self.element = element
+        self.capacity = capacity
+        self.variable = variable
+        # The length prefix is the smallest standard width holding the capacity.
+        self.prefix_bits = next(w for w in (8, 16, 32, 64) if w >= capacity.bit_length())
+
+
+class Ref:
+    def __init__(self, name, line):
+        self.name = name
+        self.line = line
+        self.composite = None
+
+
+class Composite:
+    def __init__(self, namespace, stem, name, version, port_id, path):
+        self.namespace = namespace
+        # Name of the definition file, shared by the request and response of a service.
+        self.stem = stem
+        self.name = name
+        self.version = version
+        self.port_id = port_id
+        self.path = path
+        self.fields = []
+        self.constants = []
+        self.sealed = False
+        self.extent = None
+        self.union = False
+
+    def full_name(self):
+        return ".".join(self.namespace + [self.name])
+
+    def c_name(self):
+        return "_".join(self.namespace + [self.name] + [str(v) for v in self.version])
+
+    def max_bits(self):
+        if self.union:
+            tag = union_tag_bits(self)
+            return align8(tag + max(max_bits(t) for t, _ in self.fields))
+        offset = 0
+        for t, _ in self.fields:
+            offset = align8(offset) if alignment(t) == 8 else offset
+            offset += max_bits(t)
+        return align8(offset)
+
+    def fixed(self):
+        """True if the type always serializes to the same layout."""
+        return not self.union and all(fixed(t) for t, _ in self.fields)
+
+
+def align8(bits):
+    return (bits + 7) // 8 * 8
+
+
+def alignment(t):
+    if isinstance(t, Array):
+        return 8 if t.variable else alignment(t.element)
+    return 8 if isinstance(t, Ref) else 1
+
+
+def max_bits(t):
+    """Upper bound of the serialized length of a field, excluding its alignment."""
+    if isinstance(t, (Primitive, Void)):
+        return t.bits
+    if isinstance(t, Array):
+        prefix = t.prefix_bits if t.variable else 0
+        return prefix + t.capacity * max_bits(t.element)
+    c = t.composite
+    # A delimited type may be replaced by a later version of up to its extent.
+    return c.max_bits() if c.sealed else 32 + c.extent
+
+
+def fixed(t):
+    """True if a field always serializes to the same length, with nothing to delimit."""
+    if isinstance(t, (Primitive, Void)):
+        return True
+    if isinstance(t, Array):
+        return not t.variable and fixed(t.element)
+    return t.composite.sealed and t.composite.fixed()
+
+
+def union_tag_bits(c):
+    return next(w for w in (8, 16, 32, 64) if w >= (len(c.fields) - 1).bit_length())
+
+
+def field_offsets(c):
+    """Bit offsets of the fields of a fixed layout type."""
+    offsets = []
+    offset = 0
+    for t, _ in c.fields:
+        offset = align8(offset) if alignment(t) == 8 else offset
+        offsets.append(offset)
+        offset += max_bits(t)
+    return offsets
+
+
+# Expressions
+
+BINARY_OPS = {
+    ast.Add: operator.add,
+    ast.Sub: operator.sub,
+    ast.Mult: operator.mul,
+    ast.Div: operator.truediv,
+    ast.FloorDiv: operator.floordiv,
+    ast.Mod: operator.mod,
+    ast.Pow: operator.pow,
+    ast.BitOr: operator.or_,
+    ast.BitAnd: operator.and_,
+    ast.BitXor: operator.xor,
+}
+COMPARE_OPS = {
+    ast.Eq: operator.eq,
+    ast.NotEq: operator.ne,
+    ast.Lt: operator.lt,
+    ast.LtE: operator.le,
+    ast.Gt: operator.gt,
+    ast.GtE: operator.ge,
+}
+
+
+def evaluate(text, constants):
+    text = text.replace("&&", " and ").replace("||", " or ")
+    text = re.sub(r"!(?!=)", " not ", text)
+
+    def value(node):
+        if isinstance(node, ast.Constant) and isinstance(node.value, (bool, str)):
+            return node.value
+        if isinstance(node, ast.Constant) and isinstance(node.value, (int, float)):
+            return fractions.Fraction(str(node.value))
+        if isinstance(node, ast.Name):
+            if node.id in ("true", "false"):
+                return node.id == "true"
+            if node.id in constants:
+                return constants[node.id]
+            raise DsdlError(f"unknown name {node.id}")
+        if isinstance(node, ast.BinOp) and type(node.op) in BINARY_OPS:
+            return BINARY_OPS[type(node.op)](value(node.left), value(node.right))
+        if isinstance(node, ast.UnaryOp):
+            operand = value(node.operand)
+            if isinstance(node.op, ast.USub):
+                return -operand
+            if isinstance(node.op, ast.UAdd):
+                return operand
+            if isinstance(node.op, ast.Not):
+                return not operand
+        if isinstance(node, ast.BoolOp):
+            values = [value(v) for v in node.values]
+            return all(values) if isinstance(node.op, ast.And) else any(values)
+        if isinstance(node, ast.Compare) and len(node.ops) == 1:
+            op = COMPARE_OPS.get(type(node.ops[0]))
+            if op:
+                return op(value(node.left), value(node.comparators[0]))
+        raise DsdlError(f"unsupported expression: {text.strip()}")
+
+    try:
+        return value(ast.parse(text.strip(), mode="eval").body)
+    except SyntaxError:
+        raise DsdlError(f"invalid expression: {text.strip()}")
+
+
+def evaluate_int(text, constants):
+    result = evaluate(text, constants)
+    if isinstance(result, bool) or not isinstance(result, fractions.Fraction):
+        raise DsdlError(f"expected an integer: {text.strip()}")
+    if result.denominator != 1:
+        raise DsdlError(f"expected an integer: {text.strip()}")
+    return int(result)
+
+
+# Parsing
+
+FILE_NAME = re.compile(r"^(?:(\d+)\.)?([A-Za-z_]\w*)\.(\d+)\.(\d+)\.dsdl$")
+PRIMITIVE = re.compile(r"^(bool|byte|utf8|uint(\d+)|int(\d+)|float(16|32|64)|void(\d+))$")
+ATTRIBUTE = re.compile(
+    r"^(?:(saturated|truncated)\s+)?([\w.]+)\s*(?:\[\s*(<=|<)?([^\]]+)\])?"
+    r"(?:\s+([A-Za-z_]\w*))?\s*(?:=\s*(.+))?$"
+)
+
+
+def parse_type(name, cast, line):
+    m = PRIMITIVE.match(name)
+    if not m:
+        if cast:
+            raise DsdlError("cast mode of a composite type")
+        return Ref(name, line)
+    if m.group(5):
+        bits = int(m.group(5))
+        if not 1 <= bits <= 64:
+            raise DsdlError(f"invalid void width {bits}")
+        return Void(bits)
+
+    saturated = cast != "truncated"
+    if name == "bool":
+        return Primitive("bool", 1, True)
+    if name in ("byte", "utf8"):
+        return Primitive("uint", 8, saturated)
+    if m.group(2):
+        bits = int(m.group(2))
+        if not 1 <= bits <= 64:
+            raise DsdlError(f"invalid unsigned integer width {bits}")
+        return Primitive("uint", bits, saturated)
+    if m.group(3):
+        bits = int(m.group(3))
+        if not 2 <= bits <= 64:
+            raise DsdlError(f"invalid signed integer width {bits}")
+        if not saturated:
+            raise DsdlError("signed integers cannot be truncated")
+        return Primitive("int", bits, True)
+    return Primitive("float", int(m.group(4)), saturated)
+
+
+def parse_file(root, path):
+    rel = os.path.relpath(path, root)
+    m = FILE_NAME.match(os.path.basename(rel))
+    if not m:
+        raise DsdlError(f"{path}: not a DSDL definition file name")
+    namespace = [os.path.basename(root)]
+    namespace += [p for p in os.path.dirname(rel).split(os.sep) if p]
+    port_id = int(m.group(1)) if m.group(1) else None
+    version = (int(m.group(3)), int(m.group(4)))
+
+    def new_type(suffix):
+        stem = m.group(2)
+        return Composite(namespace, stem, stem + suffix, version, port_id, path)
+
+    types = [new_type("")]
+    constants = {}
+    with open(path) as f:
+        for number, raw in enumerate(f, 1):
+            line = raw.split("#", 1)[0].strip()
+            if not line:
+                continue
+            try:
+                parse_line(types, constants, line, number, new_type)
+            except DsdlError as e:
+                raise DsdlError(f"{path}:{number}: {e}")
+
+    for t in types:
+        try:
+            check_type(t)
+        except DsdlError as e:
+            raise DsdlError(f"{path}: {t.name}: {e}")
+    return types
+
+
+def parse_line(types, constants, line, number, new_type):
+    current = types[-1]
+    if line == "---":
+        if len(types) == 2:
+            raise DsdlError("more than one service separator")
+        types[0].name += "_Request"
+        types.append(new_type("_Response"))
+        return
+
+    if line.startswith("@"):
+        directive, _, arg = line[1:].partition(" ")
+        if directive == "sealed":
+            current.sealed = True
+        elif directive == "extent":
+            current.extent = evaluate_int(arg, constants)
+        elif directive == "union":
+            current.union = True
+        elif directive not in ("assert", "print", "deprecated"):
+            raise DsdlError(f"unknown directive @{directive}")
+        return
+
+    m = ATTRIBUTE.match(line)
+    if not m:
+        raise DsdlError(f"invalid attribute: {line}")
+    cast, type_name, bound, capacity, name, value = m.groups()
+    t = parse_type(type_name, cast, number)
+
+    if value is not None:
+        if not isinstance(t, Primitive) or capacity:
+            raise DsdlError("constants must be of a primitive type")
+        result = evaluate(value, constants)
+        constants[name] = result
+        current.constants.append((t, name, result))
+        return
+
+    if capacity is not None:
+        if isinstance(t, Void):
+            raise DsdlError("arrays of void")
+        size = evaluate_int(capacity, constants) - (1 if bound == "<" else 0)
+        if size < (0 if bound else 1):
+            raise DsdlError(f"invalid array capacity {size}")
+        t = Array(t, size, bound is not None)
+    if isinstance(t, Void):
+        if name is not None:
+            raise DsdlError("padding fields have no name")
+        if current.union:
+            raise DsdlError("padding in a union")
+    elif name is None:
+        raise DsdlError(f"field without a name: {line}")
+    if name is not None and any(n == name for _, n in current.fields):
+        raise DsdlError(f"duplicate field {name}")
+    current.fields.append((t, name))
+
+
+def check_type(t):
+    if t.sealed and t.extent is not None:
+        raise DsdlError("@extent of a sealed type")
+    if not t.sealed and t.extent is None:
+        raise DsdlError("either @sealed or @extent is required")
+    if t.union and len([f for f in t.fields if f[1] is not None]) < 2:
+        raise DsdlError("a union needs at least two variants")
+
+
+def resolve(types):
+    by_name = {(".".join(t.namespace + [t.name]), t.version): t for t in types}
+    for t in types:
+        for field_type, _ in t.fields:
+            ref = field_type.element if isinstance(field_type, Array) else field_type
+            if not isinstance(ref, Ref):
+                continue
+            parts = ref.name.split(".")
+            if len(parts) < 3 or not parts[-1].isdigit() or not parts[-2].isdigit():
+                raise DsdlError(f"{t.path}:{ref.line}: unknown type {ref.name}")
+            version = (int(parts[-2]), int(parts[-1]))
+            name = ".".join(parts[:-2])
+            relative = ".".join(t.namespace + [name])
+            ref.composite = by_name.get((name, version))
+            ref.composite = ref.composite or by_name.get((relative, version))
+            if ref.composite is None:
+                raise DsdlError(f"{t.path}:{ref.line}: unknown type {ref.name}")
+
+    # Extents can only be checked once every referenced type is known.
+    visiting = set()
+
+    def check(t):
+        if t in visiting:
+            raise DsdlError(f"{t.path}: {t.name} contains itself")
+        visiting.add(t)
+        for field_type, _ in t.fields:
+            ref = field_type.element if isinstance(field_type, Array) else field_type
+            if isinstance(ref, Ref):
+                check(ref.composite)
+        visiting.discard(t)
+        if t.extent is not None:
+            if t.extent % 8 != 0:
+                raise DsdlError(f"{t.path}: {t.name}: extent not a multiple of 8 bits")
+            if t.extent < t.max_bits():
+                raise DsdlError(f"{t.path}: {t.name}: extent below the largest size")
+
+    for t in types:
+        check(t)
+
+
+# Code generation
+
+
+def ctype(t):
+    return t.composite.c_name() if isinstance(t, Ref) else t.ctype()
+
+
+def elements(t, expr):
+    """Returns the element array expression and count of an array field."""
+    if t.variable:
+        return f"{expr}.elements", f"{expr}.count"
+    return expr, str(t.capacity)
+
+
+def write_value(t, expr):
+    if t.kind == "bool":
+        return f"{expr}"
+    if t.kind == "float":
+        if t.bits == 16:
+            return f"zyphal_dsdl_f16_bits({expr}, {'true' if t.saturated else 'false'})"
+        return f"zyphal_dsdl_f{t.bits}_bits({expr})"
+    narrower = t.bits < int(re.sub(r"\D", "", t.ctype()))
+    if t.kind == "int":
+        if narrower:
+            return f"(uint64_t)zyphal_dsdl_sat_i({expr}, {t.bits})"
+        return f"(uint64_t){expr}"
+    if narrower and t.saturated:
+        return f"zyphal_dsdl_sat_u({expr}, {t.bits})"
+    return f"{expr}"
+
+
+def read_value(t, raw):
+    if t.kind == "bool":
+        return f"{raw} != 0"
+    if t.kind == "float":
+        return f"zyphal_dsdl_f{t.bits}_from_bits({raw})"
+    if t.kind == "int":
+        return f"({t.ctype()})zyphal_dsdl_sign_extend({raw}, {t.bits})"
+    return f"({t.ctype()}){raw}"
+
+
+def signature(prefix, params):
+    """Function signature, with one parameter per line if it does not fit on one."""
+    line = f"{prefix}({', '.join(params)}) {{"
+    if len(line) <= 90:
+        return line
+    indent = " " * (len(prefix) + 1)
+    return f"{prefix}(" + f",\n{indent}".join(params) + ") {"
+
+
+class Emitter:
+    def __init__(self):
+        self.lines = []
+        self.depth = 0
+
+    def __call__(self, text=""):
+        for line in text.split("\n"):
+            self.lines.append(("    " * self.depth + line) if line else "")
+
+    def open(self, line):
+        self(line)
+        self.depth += 1
+
+    def close(self, line="}"):
+        self.depth -= 1
+        self(line)
+
+
+def emit_pack(out, c, name, mode):
+    """Packs or unpacks a fixed layout type at constant offsets."""
+    offsets = field_offsets(c)
+    end = 0
+    for (t, field), offset in zip(c.fields, offsets):
+        if mode == "pack" and offset > end:
+            out(f"zyphal_dsdl_set_u64(buf, {end}, 0, {offset - end});")
+        end = offset + max_bits(t)
+        expr = f"obj->{field}"
+        if isinstance(t, Void):
+            if mode == "pack":
+                out(f"zyphal_dsdl_set_u64(buf, {offset}, 0, {t.bits});")
+        elif isinstance(t, Primitive):
+            if mode == "pack":
+                value = write_value(t, expr)
+                out(f"zyphal_dsdl_set_u64(buf, {offset}, {value}, {t.bits});")
+            else:
+                raw = f"zyphal_dsdl_get_u64(buf, {offset}, {t.bits})"
+                out(f"{expr} = {read_value(t, raw)};")
+        elif isinstance(t, Ref):
+            n = t.composite.c_name()
+            if mode == "pack":
+                out(f"{n}_pack(&buf[{offset // 8}], &{expr});")
+            else:
+                out(f"{n}_unpack(&{expr}, &buf[{offset // 8}]);")
+        elif isinstance(t.element, Primitive) and t.element.is_byte() and offset % 8 == 0:
+            if mode == "pack":
+                out(f"memcpy(&buf[{offset // 8}], {expr}, {t.capacity});")
+            else:
+                out(f"memcpy({expr}, &buf[{offset // 8}], {t.capacity});")
+        else:
+            e = t.element
+            out.open(f"for (size_t i = 0; i < {t.capacity}; i++) {{")
+            if isinstance(e, Ref):
+                n = e.composite.c_name()
+                size = e.composite.max_bits() // 8
+                if mode == "pack":
+                    out(f"{n}_pack(&buf[{offset // 8} + i * {size}], &{expr}[i]);")
+                else:
+                    out(f"{n}_unpack(&{expr}[i], &buf[{offset // 8} + i * {size}]);")
+            elif mode == "pack":
+                value = write_value(e, f"{expr}[i]")
+                bit = f"{offset} + i * {e.bits}"
+                out(f"zyphal_dsdl_set_u64(buf, {bit}, {value}, {e.bits});")
+            else:
+                raw = f"zyphal_dsdl_get_u64(buf, {offset} + i * {e.bits}, {e.bits})"
+                out(f"{expr}[i] = {read_value(e, raw)};")
+            out.close()
+    if mode == "pack" and c.max_bits() > end:
+        out(f"zyphal_dsdl_set_u64(buf, {end}, 0, {c.max_bits() - end});")
+
+
+def emit_write_field(out, t, expr):
+    if isinstance(t, Void):
+        out(f"zyphal_dsdl_write_u64(w, 0, {t.bits});")
+    elif isinstance(t, Primitive):
+        out(f"zyphal_dsdl_write_u64(w, {write_value(t, expr)}, {t.bits});")
+    elif isinstance(t, Ref):
+        c = t.composite
+        out("zyphal_dsdl_write_align(w);")
+        if not c.sealed:
+            if c.fixed():
+                out(f"zyphal_dsdl_write_u64(w, {c.c_name()}_MAX_SIZE_BYTES, 32);")
+            else:
+                out.open("{")
+                out(f"int32_t size = {c.c_name()}_serialized_size(&{expr});")
+                out.open("if (size < 0) {")
+                out("w->err = size;")
+                out("return;")
+                out.close()
+                out("zyphal_dsdl_write_u64(w, size, 32);")
+                out.close()
+        out(f"{c.c_name()}_write(w, &{expr});")
+    else:
+        items, count = elements(t, expr)
+        if t.variable:
+            out("zyphal_dsdl_write_align(w);")
+            out.open(f"if ({count} > {t.capacity}) {{")
+            out("w->err = -EINVAL;")
+            out("return;")
+            out.close()
+            out(f"zyphal_dsdl_write_u64(w, {count}, {t.prefix_bits});")
+        e = t.element
+        if isinstance(e, Primitive) and e.is_byte():
+            out(f"zyphal_dsdl_write_bytes(w, (const uint8_t*){items}, {count});")
+            return
+        if isinstance(e, Ref):
+            out("zyphal_dsdl_write_align(w);")
+        # Elements of a fixed length wholly before the window are skipped at once.
+        start = "0"
+        if fixed(e):
+            start = f"zyphal_dsdl_writer_skip(w, {max_bits(e)}, {count})"
+        condition = f"i < {count} && !zyphal_dsdl_writer_done(w)"
+        out.open(f"for (size_t i = {start}; {condition}; i++) {{")
+        emit_write_field(out, e, f"{items}[i]")
+        out.close()
+
+
+def emit_read_field(out, t, expr):
+    if isinstance(t, Void):
+        out(f"r->bit += {t.bits};")
+    elif isinstance(t, Primitive):
+        raw = f"zyphal_dsdl_read_u64(r, {t.bits})"
+        out(f"{expr} = {read_value(t, raw)};")
+    elif isinstance(t, Ref):
+        c = t.composite
+        out("zyphal_dsdl_read_align(r);")
+        if c.sealed:
+            out(f"ret = {c.c_name()}_read(r, &{expr});")
+        else:
+            out.open("{")
+            out("zyphal_dsdl_reader_t sub;")
+            out("if (!zyphal_dsdl_read_delimited(r, &sub)) { return -EBADMSG; }")
+            out(f"ret = {c.c_name()}_read(&sub, &{expr});")
+            out.close()
+        out("if (ret < 0) { return ret; }")
+    else:
+        items, count = elements(t, expr)
+        if t.variable:
+            out("zyphal_dsdl_read_align(r);")
+            out(f"{count} = zyphal_dsdl_read_u64(r, {t.prefix_bits});")
+            out(f"if ({count} > {t.capacity}) {{ return -EBADMSG; }}")
+        e = t.element
+        if isinstance(e, Primitive) and e.is_byte():
+            out(f"zyphal_dsdl_read_bytes(r, (uint8_t*){items}, {count});")
+            return
+        if isinstance(e, Ref):
+            out("zyphal_dsdl_read_align(r);")
+        out.open(f"for (size_t i = 0; i < {count}; i++) {{")
+        emit_read_field(out, e, f"{items}[i]")
+        out.close()
+
+
+def has_refs(c):
+    return any(
+        isinstance(t, Ref) or (isinstance(t, Array) and isinstance(t.element, Ref))
+        for t, _ in c.fields
+    )
+
+
+def constant_value(t, value):
+    if t.kind == "bool":
+        return "true" if value else "false"
+    if t.kind == "float":
+        return f"{float(value)!r}{'' if t.bits == 64 else 'f'}"
+    if isinstance(value, bool) or value.denominator != 1:
+        raise DsdlError(f"integer constant of a non-integer value {value}")
+    suffix = {"uint": "U", "int": ""}[t.kind] + ("LL" if t.bits > 32 else "")
+    return f"{int(value)}{suffix}"
+
+
+def emit_type(out, c):
+    n = c.c_name()
+    fixed_layout = c.fixed()
+    size = c.max_bits() // 8
+    extent = size if c.sealed else c.extent // 8
+
+    out(f"/* {c.full_name()}.{c.version[0]}.{c.version[1]} */")
+    out(f'#define {n}_FULL_NAME "{c.full_name()}"')
+    if c.port_id is not None:
+        out(f"#define {n}_FIXED_PORT_ID ({c.port_id}U)")
+    out(f"#define {n}_EXTENT_BYTES ({extent}U)")
+    out(f"#define {n}_MAX_SIZE_BYTES ({size}U)")
+    for t, name, value in c.constants:
+        out(f"#define {n}_{name} ({constant_value(t, value)})")
+    out()
+
+    out.open("typedef struct {")
+    if c.union:
+        out.open("union {")
+    members = 0
+    for t, name in c.fields:
+        if name is None:
+            continue
+        members += 1
+        if isinstance(t, Array) and t.variable:
+            out.open("struct {")
+            out(f"{ctype(t.element)} elements[{max(t.capacity, 1)}];")
+            out("size_t count;")
+            out.close(f"}} {name};")
+        elif isinstance(t, Array):
+            out(f"{ctype(t.element)} {name}[{max(t.capacity, 1)}];")
+        else:
+            out(f"{ctype(t)} {name};")
+    if c.union:
+        out.close("};")
+        out(f"uint{union_tag_bits(c)}_t _tag_;")
+    elif members == 0:
+        out("uint8_t _unused_;")
+    out.close(f"}} {n};")
+    out()
+
+    if fixed_layout:
+        params = ["uint8_t* buf", f"const {n}* obj"]
+        out.open(signature(f"static inline void {n}_pack", params))
+        if not c.fields:
+            out("ARG_UNUSED(buf);")
+            out("ARG_UNUSED(obj);")
+        emit_pack(out, c, n, "pack")
+        out.close()
+        out()
+        params = [f"{n}* obj", "const uint8_t* buf"]
+        out.open(signature(f"static inline void {n}_unpack", params))
+        if not c.fields:
+            out("ARG_UNUSED(buf);")
+            out("ARG_UNUSED(obj);")
+        emit_pack(out, c, n, "unpack")
+        out.close()
+        out()
+
+    params = ["zyphal_dsdl_writer_t* w", f"const {n}* obj"]
+    out.open(signature(f"static inline void {n}_write", params))
+    if fixed_layout:
+        out("/* Skipped if wholly before the window, packed if wholly in it. */")
+        out(f"if (zyphal_dsdl_writer_skip(w, {size * 8}, 1) > 0) {{ return; }}")
+        out(f"size_t byte = w->bit / 8;")
+        inside = f"byte >= w->start && byte + {size} <= w->end"
+        out.open(f"if (w->bit % 8 == 0 && {inside}) {{")
+        out(f"{n}_pack(&w->buf[byte - w->start], obj);")
+        out(f"w->bit += {size * 8};")
+        out("return;")
+        out.close()
+    if c.union:
+        out.open(f"if (obj->_tag_ >= {len(c.fields)}) {{")
+        out("w->err = -EINVAL;")
+        out("return;")
+        out.close()
+        out(f"zyphal_dsdl_write_u64(w, obj->_tag_, {union_tag_bits(c)});")
+        for i, (t, name) in enumerate(c.fields):
+            out.open(f"{'if' if i == 0 else '} else if'} (obj->_tag_ == {i}) {{")
+            emit_write_field(out, t, f"obj->{name}")
+            out.depth -= 1
+        out("}")
+    else:
+        for i, (t, name) in enumerate(c.fields):
+            if i > 0:
+                out("if (zyphal_dsdl_writer_done(w)) { return; }")
+            emit_write_field(out, t, f"obj->{name}")
+    out("zyphal_dsdl_write_align(w);")
+    out.close()
+    out()
+
+    params = ["zyphal_dsdl_reader_t* r", f"{n}* obj"]
+    out.open(signature(f"static inline int32_t {n}_read", params))
+    if fixed_layout:
+        out.open(f"if (r->bit % 8 == 0 && r->bit / 8 + {size} <= r->size) {{")
+        out(f"{n}_unpack(obj, &r->buf[r->bit / 8]);")
+        out(f"r->bit += {size * 8};")
+        out("return 0;")
+        out.close()
+    if has_refs(c):
+        out("int32_t ret;")
+    if c.union:
+        out(f"obj->_tag_ = zyphal_dsdl_read_u64(r, {union_tag_bits(c)});")
+        for i, (t, name) in enumerate(c.fields):
+            out.open(f"{'if' if i == 0 else '} else if'} (obj->_tag_ == {i}) {{")
+            emit_read_field(out, t, f"obj->{name}")
+            out.depth -= 1
+        out.open("} else {")
+        out("return -EBADMSG;")
+        out.close()
+    else:
+        for t, name in c.fields:
+            emit_read_field(out, t, f"obj->{name}")
+    out("zyphal_dsdl_read_align(r);")
+    out("return 0;")
+    out.close()
+    out()
+
+    out(f"/* Returns the serialized length of obj in bytes, -EINVAL if it is invalid. */")
+    out.open(signature(f"static inline int32_t {n}_serialized_size", [f"const {n}* obj"]))
+    if fixed_layout:
+        out("ARG_UNUSED(obj);")
+        out(f"return {size};")
+    else:
+        out("zyphal_dsdl_writer_t w = ZYPHAL_DSDL_MEASURE;")
+        out(f"{n}_write(&w, obj);")
+        out("return w.err != 0 ? w.err : (int32_t)(w.bit / 8);")
+    out.close()
+    out()
+
+    out("/* Serializes obj into buf of *size bytes, setting *size to the serialized")
+    out(" * length. Returns -EMSGSIZE if buf is too small, -EINVAL if obj is invalid. */")
+    params = [f"const {n}* obj", "uint8_t* buf", "size_t* size"]
+    out.open(signature(f"static inline int32_t {n}_serialize", params))
+    if fixed_layout:
+        out(f"if (*size < {size}) {{ return -EMSGSIZE; }}")
+        out(f"{n}_pack(buf, obj);")
+        out(f"*size = {size};")
+    else:
+        out("zyphal_dsdl_writer_t w = zyphal_dsdl_writer(buf, 0, *size);")
+        out(f"{n}_write(&w, obj);")
+        out("if (w.err != 0) { return w.err; }")
+        out("if (w.bit > *size * 8) { return -EMSGSIZE; }")
+        out("*size = w.bit / 8;")
+    out("return 0;")
+    out.close()
+    out()
+
+    out("/* Serializes the bytes of obj from offset into chunk, of up to size bytes.")
+    out(" * Returns the number of bytes written, zero past the end, or -EINVAL if obj is")
+    out(" * invalid. */")
+    params = [f"const {n}* obj", "size_t offset", "uint8_t* chunk", "size_t size"]
+    out.open(signature(f"static inline int32_t {n}_serialize_chunk", params))
+    out("zyphal_dsdl_writer_t w = zyphal_dsdl_writer(chunk, offset, size);")
+    out(f"{n}_write(&w, obj);")
+    out("if (w.err != 0) { return w.err; }")
+    out("return w.bit / 8 > offset ? (int32_t)MIN(w.bit / 8 - offset, size) : 0;")
+    out.close()
+    out()
+
+    out("/* Deserializes obj from buf of *size bytes, setting *size to the length")
+    out(" * consumed. Missing bytes read as zero. Returns -EBADMSG if buf holds no valid")
+    out(" * object. */")
+    params = [f"{n}* obj", "const uint8_t* buf", "size_t* size"]
+    out.open(signature(f"static inline int32_t {n}_deserialize", params))
+    out("zyphal_dsdl_reader_t r = {.buf = buf, .size = *size};")
+    out(f"int32_t ret = {n}_read(&r, obj);")
+    out("if (ret < 0) { return ret; }")
+    out("*size = MIN(r.bit / 8, *size);")
+    out("return 0;")
+    out.close()
+    out()
+
+    if c.name.endswith("_Request"):
+        return
+    emit_send(out, c)
+
+
+def emit_send(out, c):
+    n = c.c_name()
+    out("/* Payload source serializing the object given as user data. */")
+    params = ["void* obj", "size_t offset", "uint8_t* buf", "size_t len"]
+    out.open(signature(f"static inline int32_t {n}_source", params))
+    out(f"const {n}* o = (const {n}*)obj;")
+    out(f"return {n}_serialize_chunk(o, offset, buf, len);")
+    out.close()
+    out()
+
+    if c.name.endswith("_Response"):
+        out("/* Responds to a request with obj, serialized into each frame as it is")
+        out(" * sent. obj must remain unchanged until the transfer completes. */")
+        func = "respond"
+        port = ["uint16_t service_id", "uint8_t client_node_id"]
+        port += ["uint8_t transfer_id"]
+    else:
+        out("/* Publishes obj, serialized into each frame as it is sent. obj must remain")
+        out(" * unchanged until the transfer completes. */")
+        func = "publish"
+        port = ["uint16_t subject_id"]
+    params = ["zyphal_tx_t* tx", "zyphal_prio_t priority"] + port
+    params += [f"const {n}* obj", "k_timeout_t timeout", "zyphal_tx_done_cb_t cb"]
+    params += ["void* user_data"]
+    out.open(signature(f"static inline int32_t {n}_{func}", params))
+    out(f"int32_t len = {n}_serialized_size(obj);")
+    out("if (len < 0) { return len; }")
+    args = ["tx", "priority"] + [p.split()[-1] for p in port]
+    args += ["len", f"{n}_source", "(void*)obj", "timeout", "cb", "user_data"]
+    call = f"return zyphal_{func}_source("
+    indent = " " * len(call)
+    out(call + f",\n{indent}".join(args) + ");")
+    out.close()
+    out()
+
+
+def header_path(c):
+    return os.path.join(*c.namespace, f"{c.stem}_{c.version[0]}_{c.version[1]}.h")
+
+
+def generate(types, source):
+    out = Emitter()
+    first = types[0]
+    guard = re.sub(r"\W", "_", header_path(first)).upper()
+    out(f"/* Generated by scripts/gen_dsdl.py from {source}, do not edit. */")
+    out(f"#ifndef {guard}")
+    out(f"#define {guard}")
+    out()
+    out("#include <stdbool.h>")
+    out("#include <stdint.h>")
+    out("#include <zyphal/core.h>")
+    out("#include <zyphal/dsdl.h>")
+
+    deps = set()
+    for c in types:
+        for t, _ in c.fields:
+            ref = t.element if isinstance(t, Array) else t
+            if isinstance(ref, Ref) and ref.composite not in types:
+                deps.add(header_path(ref.composite).replace(os.sep, "/"))
+    if deps:
+        out()
+        for dep in sorted(deps):
+            out(f"#include <{dep}>")
+    out()
+
+    for c in types:
+        emit_type(out, c)
+    out(f"#endif /* {guard} */")
+    return "\n".join(out.lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--output", required=True)
+    parser.add_argument("namespaces", nargs="+")
+    args = parser.parse_args()
+
+    try:
+        parsed = []
+        for root in args.namespaces:
+            root = os.path.abspath(root)
+            for directory, _, names in sorted(os.walk(root)):
+                for name in sorted(n for n in names if n.endswith(".dsdl")):
+                    parsed.append(parse_file(root, os.path.join(directory, name)))
+        resolve([c for types in parsed for c in types])
+
+        for types in parsed:
+            path = os.path.join(args.output, header_path(types[0]))
+            text = generate(types, os.path.basename(types[0].path))
+            os.makedirs(os.path.dirname(path), exist_ok=True)
+            with open(path, "w") as f:
+                f.write(text)
+    except DsdlError as e:
+        print(f"error: {e}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
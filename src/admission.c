@@ -0,0 +1,119 @@
+#include <stdint.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+
+#include "admission.h"
+#include "frame.h"
+#include "zyphal/core.h"
+
+/* Bits of an extended ID frame without stuff bits, so estimates never exceed the actual
+ * bus time. CAN FD sends arbitration, ACK and end of frame at the nominal bitrate, and
+ * the control field, data and CRC with its fixed stuff bits at the data bitrate. */
+#define FD_NOMINAL_BITS (49)
+#define FD_DATA_BITS(bytes) (5 + 8 * (bytes) + ((bytes) > 16 ? 32 : 27))
+#define CLASSIC_BITS(bytes) (67 + 8 * (bytes))
+
+static uint32_t frame_airtime_us(zyphal_iface_t* iface, size_t bytes) {
+#if defined(CONFIG_ZYPHAL_CAN_FD)
+    uint64_t ns = (uint64_t)FD_NOMINAL_BITS * iface->tx_bit_ns +
+                  (uint64_t)FD_DATA_BITS(bytes) * iface->tx_data_bit_ns;
+#else
+    uint64_t ns = (uint64_t)CLASSIC_BITS(bytes) * iface->tx_bit_ns;
+#endif
+    return (uint32_t)(ns / NSEC_PER_USEC);
+}
+
+/* Every frame but the last is full, the last also carries the remaining tail, CRC and
+ * padding bytes. */
+static uint32_t transfer_airtime_us(zyphal_iface_t* iface, size_t len, size_t frames) {
+    size_t crc = frames > 1 ? MULTI_FRAME_CRC_SIZE : 0;
+    size_t bytes = len + crc + frames * TAIL_BYTE_SIZE;
+    size_t last = bytes - (frames - 1) * ZYPHAL_FRAME_MTU;
+
+    return (frames - 1) * frame_airtime_us(iface, ZYPHAL_FRAME_MTU) +
+           frame_airtime_us(iface, can_dlc_to_bytes(can_bytes_to_dlc(last)));
+}
+
+static uint8_t id_level(uint32_t id) {
+    return (id & CANID_PRIO_MASK) >> CANID_PRIO_SHIFT;
+}
+
+bool zyphal_tx_admit(zyphal_inst_t* inst,
+                     uint32_t id,
+                     size_t len,
+                     size_t frames,
+                     k_timeout_t timeout) {
+    uint8_t level = id_level(id);
+    if (level < CONFIG_ZYPHAL_TX_ADMISSION_PRIO) { return true; }
+
+    k_timeout_t left = sys_timepoint_timeout(sys_timepoint_calc(timeout));
+    if (K_TIMEOUT_EQ(left, K_FOREVER)) { return true; }
+    uint64_t budget_us = k_ticks_to_us_floor64(left.ticks);
+
+    /* The backlog is read without the mutex, a concurrent update only makes the estimate
+     * off by the frames being sent or queued at that moment. */
+    bool first = inst->tx_policy == ZYPHAL_TX_POLICY_FIRST;
+    for (size_t i = 0; i < inst->iface_count; i++) {
+        zyphal_iface_t* iface = &inst->ifaces[i];
+        bool meets = true;
+
+        /* Frames of equal or higher priority are sent first. */
+        if (iface->tx_bit_ns > 0) {
+            uint64_t wait_us = transfer_airtime_us(iface, len, frames);
+            for (size_t j = 0; j <= level; j++) { wait_us += iface->tx_backlog_us[j]; }
+            meets = wait_us <= budget_us;
+        }
+
+        /* One interface meeting the deadline is enough under the first policy, one
+         * missing it fails the transfer under the all policy. */
+        if (meets == first) { return first; }
+    }
+
+    return !first;
+}
+
+void zyphal_tx_backlog_add(zyphal_iface_t* iface, zyphal_tx_t* tx) {
+    zyphal_tx_cursor_t* cursor = &tx->cursors[iface->index];
+
+    cursor->backlog_us = iface->tx_bit_ns > 0
+                             ? transfer_airtime_us(iface, tx->payload_len, tx->frames)
+                             : 0;
+    iface->tx_backlog_us[id_level(tx->id)] += cursor->backlog_us;
+}
+
+void zyphal_tx_backlog_sent(zyphal_iface_t* iface, zyphal_tx_t* tx, uint8_t dlc) {
+    zyphal_tx_cursor_t* cursor = &tx->cursors[iface->index];
+    uint32_t airtime = MIN(frame_airtime_us(iface, can_dlc_to_bytes(dlc)),
+                           cursor->backlog_us);
+
+    cursor->backlog_us -= airtime;
+    iface->tx_backlog_us[id_level(tx->id)] -= airtime;
+}
+
+void zyphal_tx_backlog_remove(zyphal_iface_t* iface, zyphal_tx_t* tx) {
+    zyphal_tx_cursor_t* cursor = &tx->cursors[iface->index];
+
+    iface->tx_backlog_us[id_level(tx->id)] -= cursor->backlog_us;
+    cursor->backlog_us = 0;
+}
+
+int32_t zyphal_iface_bitrate_set(zyphal_inst_t* inst,
+                                 uint8_t index,
+                                 uint32_t bitrate,
+                                 uint32_t bitrate_data) {
+    if (!inst || index >= inst->iface_count || bitrate > NSEC_PER_SEC ||
+        bitrate_data > NSEC_PER_SEC) {
+        return -EINVAL;
+    }
+    zyphal_iface_t* iface = &inst->ifaces[index];
+
+    k_mutex_lock(&inst->mutex, K_FOREVER);
+
+    /* Transfers already queued keep the bus time they were charged with. */
+    iface->tx_bit_ns = bitrate > 0 ? NSEC_PER_SEC / bitrate : 0;
+    iface->tx_data_bit_ns = bitrate_data > 0 ? NSEC_PER_SEC / bitrate_data
+                                             : iface->tx_bit_ns;
+
+    k_mutex_unlock(&inst->mutex);
+    return 0;
+}
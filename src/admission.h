@@ -0,0 +1,39 @@
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+#include "zyphal/core.h"
+
+#if defined(CONFIG_ZYPHAL_TX_ADMISSION)
+/* Returns false if a transfer can not complete within the timeout even if the bus were
+ * left to this instance, safe to call from any context. */
+bool zyphal_tx_admit(zyphal_inst_t* inst,
+                     uint32_t id,
+                     size_t len,
+                     size_t frames,
+                     k_timeout_t timeout);
+/* Bus time still needed by the queued frames of each interface, updated when a transfer
+ * is queued, each time one of its frames is sent, and when it leaves the interface.
+ * Callers must hold the instance mutex. */
+void zyphal_tx_backlog_add(zyphal_iface_t* iface, zyphal_tx_t* tx);
+void zyphal_tx_backlog_sent(zyphal_iface_t* iface, zyphal_tx_t* tx, uint8_t dlc);
+void zyphal_tx_backlog_remove(zyphal_iface_t* iface, zyphal_tx_t* tx);
+#else
+static inline bool zyphal_tx_admit(zyphal_inst_t* inst,
+                                   uint32_t id,
+                                   size_t len,
+                                   size_t frames,
+                                   k_timeout_t timeout) {
+    return true;
+}
+static inline void zyphal_tx_backlog_add(zyphal_iface_t* iface, zyphal_tx_t* tx) {}
+static inline void zyphal_tx_backlog_sent(zyphal_iface_t* iface,
+                                          zyphal_tx_t* tx,
+                                          uint8_t dlc) {}
+static inline void zyphal_tx_backlog_remove(zyphal_iface_t* iface, zyphal_tx_t* tx) {}
+#endif
+
+#endif /* ADMISSION_H */
@@ -0,0 +1,50 @@
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+
+#include "crc.h"
+#include "zyphal/core.h"
+
+#if defined(CONFIG_ZYPHAL_CRC_TABLE)
+
+#include "crc_tables.h"
+
+#define CRC_SLICES (CONFIG_ZYPHAL_CRC_TABLE_SLICES)
+
+static inline uint16_t crc16_byte(uint16_t crc, uint8_t byte) {
+    return (uint16_t)(crc << 8) ^ crc_tables[0][(uint8_t)(crc >> 8) ^ byte];
+}
+
+uint16_t zyphal_crc16(uint16_t crc, const uint8_t* data, size_t len) {
+#if CRC_SLICES > 1
+    /* The CRC is folded into the first two bytes of each slice, and every byte is then
+     * looked up in the table accounting for the bytes that follow it. */
+    while (len >= CRC_SLICES) {
+        uint16_t next = crc_tables[CRC_SLICES - 1][data[0] ^ (uint8_t)(crc >> 8)] ^
+                        crc_tables[CRC_SLICES - 2][data[1] ^ (uint8_t)crc];
+        for (size_t i = 2; i < CRC_SLICES; i++) {
+            next ^= crc_tables[CRC_SLICES - 1 - i][data[i]];
+        }
+        crc = next;
+        data += CRC_SLICES;
+        len -= CRC_SLICES;
+    }
+#endif
+
+    while (len-- > 0) { crc = crc16_byte(crc, *data++); }
+    return crc;
+}
+
+#elif defined(CONFIG_ZYPHAL_CRC_CUSTOM)
+
+uint16_t zyphal_crc16(uint16_t crc, const uint8_t* data, size_t len) {
+    return zyphal_crc16_custom(crc, data, len);
+}
+
+#else
+
+uint16_t zyphal_crc16(uint16_t crc, const uint8_t* data, size_t len) {
+    return crc16_itu_t(crc, data, len);
+}
+
+#endif
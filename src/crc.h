@@ -0,0 +1,11 @@
+#ifndef CRC_H
+#define CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Updates a Cyphal transfer CRC (CRC-16/CCITT-FALSE) with the given data, using the
+ * backend selected by CONFIG_ZYPHAL_CRC_BACKEND. */
+uint16_t zyphal_crc16(uint16_t crc, const uint8_t* data, size_t len);
+
+#endif /* CRC_H */
@@ -0,0 +1,51 @@
+#include <stdint.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+
+#include "filter.h"
+
+struct can_filter zyphal_filter_merge(const struct can_filter* a,
+                                      const struct can_filter* b) {
+    /* Only bits both filters constrain to the same value can remain constrained. */
+    uint32_t mask = a->mask & b->mask & ~(a->id ^ b->id);
+    return (struct can_filter){
+        .id = a->id & mask,
+        .mask = mask,
+        .flags = a->flags,
+    };
+}
+
+uint32_t zyphal_filter_rank(const struct can_filter* filter) {
+    return (uint32_t)__builtin_popcount(filter->mask & CAN_EXT_ID_MASK);
+}
+
+bool zyphal_filter_covers(const struct can_filter* outer,
+                          const struct can_filter* inner) {
+    return (outer->mask & ~inner->mask) == 0 &&
+           (inner->id & outer->mask) == (outer->id & outer->mask);
+}
+
+bool zyphal_filter_overlaps(const struct can_filter* a, const struct can_filter* b) {
+    return ((a->id ^ b->id) & a->mask & b->mask) == 0;
+}
+
+void zyphal_filter_best_pair(const struct can_filter* filters,
+                             size_t count,
+                             size_t* a,
+                             size_t* b) {
+    uint32_t best_rank = 0;
+    *a = 0;
+    *b = 1;
+
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = i + 1; j < count; j++) {
+            struct can_filter merged = zyphal_filter_merge(&filters[i], &filters[j]);
+            uint32_t rank = zyphal_filter_rank(&merged);
+            if (rank > best_rank) {
+                best_rank = rank;
+                *a = i;
+                *b = j;
+            }
+        }
+    }
+}
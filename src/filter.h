@@ -0,0 +1,23 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/drivers/can.h>
+
+/* Returns the most selective filter accepting every frame either filter accepts. */
+struct can_filter zyphal_filter_merge(const struct can_filter* a,
+                                      const struct can_filter* b);
+/* Number of constrained ID bits, higher ranked filters let fewer frames through. */
+uint32_t zyphal_filter_rank(const struct can_filter* filter);
+/* Returns true if every frame accepted by inner is also accepted by outer. */
+bool zyphal_filter_covers(const struct can_filter* outer, const struct can_filter* inner);
+/* Returns true if some frame is accepted by both filters. */
+bool zyphal_filter_overlaps(const struct can_filter* a, const struct can_filter* b);
+/* Finds the pair of filters that loses the least rank when merged. */
+void zyphal_filter_best_pair(const struct can_filter* filters,
+                             size_t count,
+                             size_t* a,
+                             size_t* b);
+
+#endif /* FILTER_H */
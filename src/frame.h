@@ -0,0 +1,73 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/sys/util.h>
+
+#define ZYPHAL_FRAME_MTU COND_CODE_1(CONFIG_ZYPHAL_CAN_FD, (64), (8))
+
+#define CANID_PRIO_SHIFT (26)
+#define CANID_PRIO_MASK GENMASK(28, 26)
+#define CANID_SERVICE_BIT BIT(25)
+#define CANID_REQUEST_BIT BIT(24)
+#define CANID_MSG_ANONYMOUS_BIT BIT(24)
+#define CANID_RESERVED_ZERO_BIT BIT(23)
+#define CANID_MSG_RESERVED_BITS (BIT(22) | BIT(21))
+#define CANID_SERVICE_ID_SHIFT (14)
+#define CANID_SERVICE_ID_MASK GENMASK(22, 14)
+#define CANID_SUBJECT_ID_SHIFT (8)
+#define CANID_SUBJECT_ID_MASK GENMASK(20, 8)
+#define CANID_DESTINATION_ID_SHIFT (7)
+#define CANID_DESTINATION_ID_MASK GENMASK(13, 7)
+#define CANID_SOURCE_ID_MASK GENMASK(6, 0)
+
+#define TAIL_START_BIT BIT(7)
+#define TAIL_END_BIT BIT(6)
+#define TAIL_TOGGLE_BIT BIT(5)
+#define TAIL_TRANSFER_ID_MASK GENMASK(4, 0)
+
+#define TAIL_BYTE_SIZE (1)
+#define MULTI_FRAME_CRC_SIZE (2)
+
+/* DLC of the smallest frame holding len bytes. Classic CAN has a DLC for every length
+ * up to the MTU, so frames are never padded. */
+static inline uint8_t frame_len_to_dlc(size_t len) {
+#if defined(CONFIG_ZYPHAL_CAN_FD)
+    if (len <= 8) { return len; }
+    if (len <= 24) { return (len + 3) / 4 + 6; }
+    return (len + 15) / 16 + 11;
+#else
+    return len;
+#endif
+}
+
+static inline size_t frame_dlc_to_len(uint8_t dlc) {
+    return COND_CODE_1(CONFIG_ZYPHAL_CAN_FD, (can_dlc_to_bytes(dlc)), (dlc));
+}
+
+static inline uint32_t make_canid(uint8_t priority,
+                                  bool is_service,
+                                  bool is_request,
+                                  uint16_t service_id,
+                                  uint16_t subject_id,
+                                  uint8_t destination_id,
+                                  uint8_t source_id) {
+    uint32_t canid = (priority << CANID_PRIO_SHIFT) & CANID_PRIO_MASK;
+    if (is_service) {
+        canid |= CANID_SERVICE_BIT;
+        canid |= is_request ? CANID_REQUEST_BIT : 0;
+        canid |= (service_id << CANID_SERVICE_ID_SHIFT) & CANID_SERVICE_ID_MASK;
+        canid |=
+            (destination_id << CANID_DESTINATION_ID_SHIFT) & CANID_DESTINATION_ID_MASK;
+    } else {
+        canid |= CANID_MSG_RESERVED_BITS;
+        canid |= (subject_id << CANID_SUBJECT_ID_SHIFT) & CANID_SUBJECT_ID_MASK;
+    }
+    canid |= source_id & CANID_SOURCE_ID_MASK;
+    return canid;
+}
+
+#endif /* FRAME_H */
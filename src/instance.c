@@ -4,22 +4,71 @@
 
 LOG_MODULE_REGISTER(zyphal, CONFIG_CAN_LOG_LEVEL);
 
+#include "periodic.h"
+#include "receive.h"
+#include "service.h"
 #include "transmit.h"
+#include "tx_pool.h"
 #include "zyphal/core.h"
 
+/* Marks an instance initialized before, arbitrary but unlikely in memory never zeroed. */
+#define INST_INITIALIZED (0x7A797068)
+
 int32_t zyphal_init(zyphal_inst_t* inst, const struct device* canbus, uint8_t node_id) {
     if (!inst || node_id > ZYPHAL_MAX_NODE_ID) {
         return -EINVAL;
+    } else if (inst->initialized != 0 && inst->initialized != INST_INITIALIZED) {
+        return -EINVAL;
     } else if (!device_is_ready(canbus)) {
         return -ENODEV;
     } else if (k_mutex_init(&inst->mutex) < 0) {
         return -EAGAIN;
     }
 
-    inst->canbus = canbus;
+    inst->ifaces[0].canbus = canbus;
+    inst->iface_count = 1;
     inst->node_id = node_id;
-    sys_slist_init(&inst->tx_queue);
-    k_work_init_delayable(&inst->tx_work, zyphal_tx_work_handler);
+    zyphal_tx_inst_init(inst);
+    /* Work queue threads keep running if the instance is initialized again. */
+    if (inst->initialized != INST_INITIALIZED) {
+        zyphal_tx_workq_start(inst);
+        zyphal_rx_workq_start(inst);
+        inst->initialized = INST_INITIALIZED;
+    }
+    zyphal_rx_init(inst);
+    zyphal_rpc_init(inst);
+#if defined(CONFIG_ZYPHAL_PERIODIC)
+    zyphal_periodic_init(inst);
+#endif
+#if defined(CONFIG_ZYPHAL_TX_POOL)
+    zyphal_tx_pool_init(inst);
+#endif
 
     return 0;
 }
+
+int32_t zyphal_iface_add(zyphal_inst_t* inst, const struct device* canbus) {
+    if (!inst) {
+        return -EINVAL;
+    } else if (!device_is_ready(canbus)) {
+        return -ENODEV;
+    }
+
+    k_mutex_lock(&inst->mutex, K_FOREVER);
+
+    int32_t ret = 0;
+    if (inst->iface_count >= CONFIG_ZYPHAL_IFACE_MAX) {
+        ret = -ENOMEM;
+    } else if (!sys_slist_is_empty(&inst->rx_subs)) {
+        /* Filters of existing subscriptions are not installed on new interfaces. */
+        ret = -EBUSY;
+    } else {
+        zyphal_iface_t* iface = &inst->ifaces[inst->iface_count];
+        iface->canbus = canbus;
+        zyphal_rx_iface_init(iface);
+        inst->iface_count++;
+    }
+
+    k_mutex_unlock(&inst->mutex);
+    return ret;
+}
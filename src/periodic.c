@@ -0,0 +1,213 @@
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/slist.h>
+
+LOG_MODULE_DECLARE(zyphal);
+
+#include "periodic.h"
+#include "transmit.h"
+#include "zyphal/core.h"
+
+#define PERIODIC_WHEEL_MASK (CONFIG_ZYPHAL_PERIODIC_WHEEL_SIZE - 1)
+#define PERIODIC_SLOT_TICKS \
+    MAX((int64_t)k_us_to_ticks_ceil64(CONFIG_ZYPHAL_PERIODIC_RESOLUTION_US), 1)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_ZYPHAL_PERIODIC_WHEEL_SIZE));
+
+static sys_slist_t* periodic_slot(zyphal_inst_t* inst, int64_t release) {
+    return &inst->periodic_wheel[(release / PERIODIC_SLOT_TICKS) & PERIODIC_WHEEL_MASK];
+}
+
+static void periodic_done_cb(void* user_data, int32_t status) {
+    zyphal_periodic_t* per = (zyphal_periodic_t*)user_data;
+
+    /* Called from the transmit work with the instance mutex held, like every other
+     * update of the counters. Expired, failed and canceled messages are all missed. */
+    if (status < 0) { per->stats.missed++; }
+}
+
+/* Publishes the message of a due publisher, and advances it to its next release. */
+static void periodic_release(zyphal_periodic_t* per, int64_t now) {
+    int64_t late = now - per->release;
+    per->stats.jitter_last = (uint32_t)late;
+    per->stats.jitter_max = MAX(per->stats.jitter_max, (uint32_t)late);
+
+    /* A message that can no longer meet its deadline is not worth building. */
+    if (zyphal_tx_pending(&per->tx) || late >= per->deadline) {
+        per->stats.missed++;
+    } else {
+        int32_t len = per->cb(per->buffer, per->size, per->user_data);
+        if (len >= 0) {
+            int32_t ret = zyphal_publish(&per->tx,
+                                         per->priority,
+                                         per->subject_id,
+                                         per->buffer,
+                                         MIN((size_t)len, per->size),
+                                         K_TICKS(per->deadline - late),
+                                         periodic_done_cb,
+                                         per);
+            if (ret < 0) {
+                per->stats.missed++;
+            } else {
+                per->stats.published++;
+            }
+        }
+    }
+
+    /* Releases stay on the original phase, periods skipped while late are missed. */
+    per->release += per->period;
+    if (per->release <= now) {
+        int64_t skipped = (now - per->release) / per->period + 1;
+        per->stats.missed += skipped;
+        per->release += skipped * per->period;
+    }
+}
+
+static void periodic_schedule(zyphal_inst_t* inst, int64_t now) {
+    if (inst->periodic_count == 0) { return; }
+
+    /* Wake up for the next slot holding any publisher, those due in a later turn of the
+     * wheel are skipped once visited. */
+    for (size_t i = 0; i < CONFIG_ZYPHAL_PERIODIC_WHEEL_SIZE; i++) {
+        int64_t pos = inst->periodic_pos + i;
+        if (!sys_slist_is_empty(&inst->periodic_wheel[pos & PERIODIC_WHEEL_MASK])) {
+            int64_t delay = MAX(pos * PERIODIC_SLOT_TICKS - now, 0);
+            k_work_reschedule_for_queue(
+                zyphal_tx_workq(inst), &inst->periodic_work, K_TICKS(delay));
+            return;
+        }
+    }
+}
+
+static void periodic_work_handler(struct k_work* work) {
+    struct k_work_delayable* dwork = k_work_delayable_from_work(work);
+    zyphal_inst_t* inst = CONTAINER_OF(dwork, zyphal_inst_t, periodic_work);
+
+    k_mutex_lock(&inst->mutex, K_FOREVER);
+
+    /* Visit every slot passed since the last run, at most one full turn. */
+    int64_t now = k_uptime_ticks();
+    int64_t now_pos = now / PERIODIC_SLOT_TICKS;
+    if (now_pos - inst->periodic_pos >= CONFIG_ZYPHAL_PERIODIC_WHEEL_SIZE) {
+        inst->periodic_pos = now_pos - CONFIG_ZYPHAL_PERIODIC_WHEEL_SIZE + 1;
+    }
+
+    for (; inst->periodic_pos <= now_pos; inst->periodic_pos++) {
+        sys_slist_t* slot = periodic_slot(inst, inst->periodic_pos * PERIODIC_SLOT_TICKS);
+        zyphal_periodic_t* per;
+        zyphal_periodic_t* next;
+        SYS_SLIST_FOR_EACH_CONTAINER_SAFE (slot, per, next, node) {
+            if (per->release > now) { continue; }
+
+            sys_slist_find_and_remove(slot, &per->node);
+            periodic_release(per, now);
+            sys_slist_append(periodic_slot(inst, per->release), &per->node);
+        }
+    }
+
+    periodic_schedule(inst, now);
+    k_mutex_unlock(&inst->mutex);
+}
+
+void zyphal_periodic_init(zyphal_inst_t* inst) {
+    for (size_t i = 0; i < ARRAY_SIZE(inst->periodic_wheel); i++) {
+        sys_slist_init(&inst->periodic_wheel[i]);
+    }
+    inst->periodic_count = 0;
+    inst->periodic_pos = 0;
+    k_work_init_delayable(&inst->periodic_work, periodic_work_handler);
+}
+
+int32_t zyphal_periodic_start(zyphal_inst_t* inst,
+                              zyphal_periodic_t* per,
+                              zyphal_prio_t priority,
+                              uint16_t subject_id,
+                              k_timeout_t period,
+                              k_timeout_t deadline,
+                              uint8_t* buffer,
+                              size_t size,
+                              zyphal_periodic_cb_t cb,
+                              void* user_data) {
+    if (!inst || !per || !cb || (!buffer && size > 0) ||
+        priority > ZYPHAL_PRIO_OPTIONAL || subject_id > ZYPHAL_MAX_SUBJECT_ID ||
+        K_TIMEOUT_EQ(period, K_FOREVER) || period.ticks <= 0 ||
+        K_TIMEOUT_EQ(deadline, K_FOREVER) || deadline.ticks <= 0) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&inst->mutex, K_FOREVER);
+
+    /* A running publisher may still have its message queued or in flight. */
+    if (sys_slist_find(periodic_slot(inst, per->release), &per->node, NULL)) {
+        k_mutex_unlock(&inst->mutex);
+        return -EALREADY;
+    }
+
+    (void)zyphal_tx_init(inst, &per->tx);
+    per->buffer = buffer;
+    per->size = size;
+    per->period = period.ticks;
+    per->deadline = deadline.ticks;
+    per->priority = priority;
+    per->subject_id = subject_id;
+    per->cb = cb;
+    per->user_data = user_data;
+    per->stats = (zyphal_periodic_stats_t){0};
+
+    int64_t now = k_uptime_ticks();
+    int64_t now_pos = now / PERIODIC_SLOT_TICKS;
+    if (inst->periodic_count == 0) { inst->periodic_pos = now_pos + 1; }
+
+    /* Spread phases, the first release goes to the least occupied slot within the first
+     * period, so publishers of equal periods do not burst onto the bus together. */
+    int64_t span = MIN(DIV_ROUND_UP(per->period, PERIODIC_SLOT_TICKS),
+                       CONFIG_ZYPHAL_PERIODIC_WHEEL_SIZE);
+    int64_t best = now_pos + 1;
+    size_t best_len = SIZE_MAX;
+    for (int64_t pos = now_pos + 1; pos <= now_pos + span; pos++) {
+        size_t len = sys_slist_len(&inst->periodic_wheel[pos & PERIODIC_WHEEL_MASK]);
+        if (len < best_len) {
+            best = pos;
+            best_len = len;
+        }
+    }
+    per->release = best * PERIODIC_SLOT_TICKS;
+    sys_slist_append(periodic_slot(inst, per->release), &per->node);
+    inst->periodic_count++;
+
+    periodic_schedule(inst, now);
+    k_mutex_unlock(&inst->mutex);
+
+    return 0;
+}
+
+int32_t zyphal_periodic_stop(zyphal_periodic_t* per) {
+    if (!per || !per->tx.inst) { return -EINVAL; }
+    zyphal_inst_t* inst = per->tx.inst;
+
+    k_mutex_lock(&inst->mutex, K_FOREVER);
+
+    int32_t ret = 0;
+    if (!sys_slist_find_and_remove(periodic_slot(inst, per->release), &per->node)) {
+        ret = -EALREADY;
+    } else {
+        inst->periodic_count--;
+        if (zyphal_tx_pending(&per->tx)) { zyphal_tx_cancel(&per->tx); }
+    }
+
+    k_mutex_unlock(&inst->mutex);
+    return ret;
+}
+
+int32_t zyphal_periodic_stats_get(zyphal_periodic_t* per,
+                                  zyphal_periodic_stats_t* stats) {
+    if (!per || !per->tx.inst || !stats) { return -EINVAL; }
+    zyphal_inst_t* inst = per->tx.inst;
+
+    k_mutex_lock(&inst->mutex, K_FOREVER);
+    *stats = per->stats;
+    k_mutex_unlock(&inst->mutex);
+
+    return 0;
+}
@@ -0,0 +1,9 @@
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#include "zyphal/core.h"
+
+/* Initializes the periodic publisher timer wheel of an instance. */
+void zyphal_periodic_init(zyphal_inst_t* inst);
+
+#endif /* PERIODIC_H */
@@ -0,0 +1,745 @@
+#include <stdint.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/slist.h>
+
+LOG_MODULE_DECLARE(zyphal);
+
+#include "crc.h"
+#include "filter.h"
+#include "frame.h"
+#include "receive.h"
+#include "transmit.h"
+#include "zyphal/core.h"
+
+#define RX_SESSION_NONE (UINT8_MAX)
+#define RX_FILTER_NONE (UINT8_MAX)
+#define RX_TRANSFER_ID_TIMEOUT_TICKS \
+    ((int64_t)k_ms_to_ticks_ceil64(CONFIG_ZYPHAL_RX_TRANSFER_ID_TIMEOUT_MS))
+
+#define RX_PORT_TABLE_MASK (CONFIG_ZYPHAL_RX_PORT_TABLE_SIZE - 1)
+#define RX_RING_MASK (CONFIG_ZYPHAL_RX_RING_DEPTH - 1)
+
+BUILD_ASSERT(CONFIG_ZYPHAL_RX_SESSIONS < RX_SESSION_NONE);
+BUILD_ASSERT(CONFIG_ZYPHAL_RX_FILTER_SLOTS < RX_FILTER_NONE);
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_ZYPHAL_RX_PORT_TABLE_SIZE));
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_ZYPHAL_RX_RING_DEPTH));
+
+static void rx_work_handler(struct k_work* work);
+
+void zyphal_rx_init(zyphal_inst_t* inst) {
+    sys_slist_init(&inst->rx_subs);
+    memset(inst->rx_ports, 0, sizeof(inst->rx_ports));
+    memset(inst->rx_filters, 0, sizeof(inst->rx_filters));
+    inst->rx_filter_budget = CONFIG_ZYPHAL_RX_FILTER_SLOTS;
+    zyphal_rx_iface_init(&inst->ifaces[0]);
+
+    /* Chain every session into the free list. */
+    for (uint8_t i = 0; i < CONFIG_ZYPHAL_RX_SESSIONS; i++) {
+        inst->rx_sessions[i].owner = NULL;
+        inst->rx_sessions[i].next_free =
+            (i + 1 < CONFIG_ZYPHAL_RX_SESSIONS) ? i + 1 : RX_SESSION_NONE;
+    }
+    inst->rx_free = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(inst->ifaces); i++) {
+        zyphal_iface_t* iface = &inst->ifaces[i];
+        atomic_clear(&iface->rx_ring_head);
+        atomic_clear(&iface->rx_ring_tail);
+        atomic_clear(&iface->rx_ring_overflows);
+        for (uint8_t s = 0; s < CONFIG_ZYPHAL_RX_FILTER_SLOTS; s++) {
+            iface->rx_filter_refs[s] =
+                (zyphal_rx_filter_ref_t){.iface = iface, .slot = s};
+        }
+    }
+    inst->rx_stats = (zyphal_rx_stats_t){0};
+    k_work_init(&inst->rx_work, rx_work_handler);
+}
+
+void zyphal_rx_workq_start(zyphal_inst_t* inst) {
+#if defined(CONFIG_ZYPHAL_RX_WORKQ)
+    const struct k_work_queue_config cfg = {.name = "zyphal_rx"};
+    k_work_queue_init(&inst->rx_workq);
+    k_work_queue_start(&inst->rx_workq,
+                       inst->rx_workq_stack,
+                       K_KERNEL_STACK_SIZEOF(inst->rx_workq_stack),
+                       CONFIG_ZYPHAL_RX_WORKQ_PRIORITY,
+                       &cfg);
+#else
+    ARG_UNUSED(inst);
+#endif
+}
+
+struct k_work_q* zyphal_rx_workq(zyphal_inst_t* inst) {
+    return COND_CODE_1(
+        CONFIG_ZYPHAL_RX_WORKQ, (&inst->rx_workq), (zyphal_tx_workq(inst)));
+}
+
+void zyphal_rx_iface_init(zyphal_iface_t* iface) {
+    zyphal_inst_t* inst = iface->inst;
+
+    /* Every slot is installed on every interface, so never plan for more filters than
+     * the smallest controller provides. */
+    int max_filters = can_get_max_filters(iface->canbus, true);
+    if (max_filters > 0) {
+        inst->rx_filter_budget = MIN(inst->rx_filter_budget, (size_t)max_filters);
+    }
+}
+
+/* Subject and service IDs overlap, so ports are looked up by ID and transfer kind. */
+static uint16_t rx_port_key(uint8_t kind, uint16_t port_id) {
+    return ((uint16_t)kind << 13) | port_id;
+}
+
+static size_t rx_port_hash(uint16_t port_key) {
+    return (((uint32_t)port_key * 2654435761U) >> 16) & RX_PORT_TABLE_MASK;
+}
+
+static zyphal_sub_t* rx_port_lookup(zyphal_inst_t* inst, uint16_t port_key) {
+    for (size_t i = rx_port_hash(port_key);; i = (i + 1) & RX_PORT_TABLE_MASK) {
+        zyphal_sub_t* sub = inst->rx_ports[i];
+        if (sub == NULL || sub->port_key == port_key) { return sub; }
+    }
+}
+
+static void rx_port_insert(zyphal_inst_t* inst, zyphal_sub_t* sub) {
+    size_t i = rx_port_hash(sub->port_key);
+    while (inst->rx_ports[i] != NULL) { i = (i + 1) & RX_PORT_TABLE_MASK; }
+    inst->rx_ports[i] = sub;
+}
+
+static void rx_port_remove(zyphal_inst_t* inst, zyphal_sub_t* sub) {
+    size_t i = rx_port_hash(sub->port_key);
+    while (inst->rx_ports[i] != sub) { i = (i + 1) & RX_PORT_TABLE_MASK; }
+    inst->rx_ports[i] = NULL;
+
+    /* Shift back any following entries that would no longer be reachable from their
+     * home slot, so lookups can always stop at the first empty slot. */
+    for (size_t j = (i + 1) & RX_PORT_TABLE_MASK; inst->rx_ports[j] != NULL;
+         j = (j + 1) & RX_PORT_TABLE_MASK) {
+        size_t home = rx_port_hash(inst->rx_ports[j]->port_key);
+        bool reachable = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!reachable) {
+            inst->rx_ports[i] = inst->rx_ports[j];
+            inst->rx_ports[j] = NULL;
+            i = j;
+        }
+    }
+}
+
+static void rx_frame_callback(const struct device* dev,
+                              struct can_frame* frame,
+                              void* user_data);
+
+/* Replaces the filter of a slot on one interface, or adds it if the slot is unused. */
+static int32_t rx_filter_install_iface(zyphal_iface_t* iface,
+                                       uint8_t slot,
+                                       const struct can_filter* filter) {
+    zyphal_rx_filter_t* f = &iface->inst->rx_filters[slot];
+    zyphal_rx_filter_ref_t* ref = &iface->rx_filter_refs[slot];
+    int* filter_id = &f->filter_id[iface->index];
+    if (f->members > 0) { can_remove_rx_filter(iface->canbus, *filter_id); }
+
+    int ret = can_add_rx_filter(iface->canbus, rx_frame_callback, ref, filter);
+    if (ret < 0) {
+        /* Try to leave the previous filter in place for the slot's other members. */
+        if (f->members > 0) {
+            *filter_id =
+                can_add_rx_filter(iface->canbus, rx_frame_callback, ref, &f->filter);
+        }
+        return ret;
+    }
+
+    *filter_id = ret;
+    return 0;
+}
+
+static int32_t rx_filter_install(zyphal_inst_t* inst,
+                                 uint8_t slot,
+                                 const struct can_filter* filter) {
+    zyphal_rx_filter_t* f = &inst->rx_filters[slot];
+
+    for (size_t i = 0; i < inst->iface_count; i++) {
+        int32_t ret = rx_filter_install_iface(&inst->ifaces[i], slot, filter);
+        if (ret < 0) {
+            /* Keep the slot consistent across interfaces, undoing the ones done. */
+            while (i-- > 0) {
+                if (f->members > 0) {
+                    (void)rx_filter_install_iface(&inst->ifaces[i], slot, &f->filter);
+                } else {
+                    can_remove_rx_filter(inst->ifaces[i].canbus, f->filter_id[i]);
+                }
+            }
+            return ret;
+        }
+    }
+
+    f->filter = *filter;
+    return 0;
+}
+
+static void rx_filter_uninstall(zyphal_inst_t* inst, zyphal_rx_filter_t* f) {
+    for (size_t i = 0; i < inst->iface_count; i++) {
+        can_remove_rx_filter(inst->ifaces[i].canbus, f->filter_id[i]);
+    }
+}
+
+/* Returns true if the filter of either slot passes frames of a subscription of the
+ * other, which would then be delivered twice. */
+static bool rx_filter_shares(zyphal_inst_t* inst, uint8_t s, uint8_t c) {
+    zyphal_rx_filter_t* filters = inst->rx_filters;
+    zyphal_sub_t* cur;
+    SYS_SLIST_FOR_EACH_CONTAINER(&inst->rx_subs, cur, node) {
+        if ((cur->filter_slot == c &&
+             zyphal_filter_overlaps(&filters[s].filter, &cur->filter)) ||
+            (cur->filter_slot == s &&
+             zyphal_filter_overlaps(&filters[c].filter, &cur->filter))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Merges into a slot every other slot sharing frames with it, until every subscribed
+ * frame is passed by a single slot. Should a controller refuse the merged filter, the
+ * slots are left as they are, frames passed by both are only accepted from the slot of
+ * their subscription. */
+static void rx_filter_fold(zyphal_inst_t* inst, uint8_t s) {
+    zyphal_rx_filter_t* filters = inst->rx_filters;
+    bool folded;
+
+    do {
+        folded = false;
+        for (uint8_t c = 0; c < inst->rx_filter_budget; c++) {
+            if (c == s || filters[c].members == 0 || !rx_filter_shares(inst, s, c)) {
+                continue;
+            }
+
+            struct can_filter merged =
+                zyphal_filter_merge(&filters[s].filter, &filters[c].filter);
+            if ((merged.id != filters[s].filter.id ||
+                 merged.mask != filters[s].filter.mask) &&
+                rx_filter_install(inst, s, &merged) < 0) {
+                return;
+            }
+
+            zyphal_sub_t* cur;
+            SYS_SLIST_FOR_EACH_CONTAINER(&inst->rx_subs, cur, node) {
+                if (cur->filter_slot == c) { cur->filter_slot = s; }
+            }
+            filters[s].members += filters[c].members;
+            rx_filter_uninstall(inst, &filters[c]);
+            filters[c].members = 0;
+            folded = true;
+        }
+    } while (folded);
+}
+
+/* Assigns a new subscription to a filter slot, only reprogramming the controller
+ * filters that change. The subscription must already be in the instance subscription
+ * list. */
+static int32_t rx_filter_add(zyphal_inst_t* inst, zyphal_sub_t* sub) {
+    zyphal_rx_filter_t* filters = inst->rx_filters;
+    size_t budget = inst->rx_filter_budget;
+    int32_t ret;
+
+    sub->filter_slot = RX_FILTER_NONE;
+
+    /* An existing slot may already pass this port, as may another slot widened since,
+     * which is then folded into it. */
+    for (uint8_t s = 0; s < budget; s++) {
+        if (filters[s].members > 0 &&
+            zyphal_filter_covers(&filters[s].filter, &sub->filter)) {
+            sub->filter_slot = s;
+            filters[s].members++;
+            rx_filter_fold(inst, s);
+            return 0;
+        }
+    }
+
+    /* Exact filter in a free slot. */
+    for (uint8_t s = 0; s < budget; s++) {
+        if (filters[s].members == 0) {
+            ret = rx_filter_install(inst, s, &sub->filter);
+            if (ret < 0) { return ret; }
+            sub->filter_slot = s;
+            filters[s].members = 1;
+            return 0;
+        }
+    }
+
+    /* All slots in use, either widen the slot closest to this port, or merge the two
+     * closest slots and give the freed one to this port. Whichever keeps more ID bits
+     * constrained lets fewer unwanted frames through. Either way the widened slot may
+     * now pass frames of other slots, which are then folded into it. */
+    uint8_t into = 0;
+    uint32_t into_rank = 0;
+    struct can_filter slot_filters[CONFIG_ZYPHAL_RX_FILTER_SLOTS];
+    for (uint8_t s = 0; s < budget; s++) {
+        slot_filters[s] = filters[s].filter;
+        struct can_filter merged = zyphal_filter_merge(&filters[s].filter, &sub->filter);
+        if (zyphal_filter_rank(&merged) > into_rank) {
+            into_rank = zyphal_filter_rank(&merged);
+            into = s;
+        }
+    }
+
+    size_t a, b;
+    uint32_t pair_rank = 0;
+    if (budget > 1) {
+        zyphal_filter_best_pair(slot_filters, budget, &a, &b);
+        struct can_filter merged =
+            zyphal_filter_merge(&slot_filters[a], &slot_filters[b]);
+        pair_rank = zyphal_filter_rank(&merged);
+    }
+
+    if (pair_rank <= into_rank) {
+        struct can_filter merged =
+            zyphal_filter_merge(&filters[into].filter, &sub->filter);
+        ret = rx_filter_install(inst, into, &merged);
+        if (ret < 0) { return ret; }
+        sub->filter_slot = into;
+        filters[into].members++;
+        rx_filter_fold(inst, into);
+        return 0;
+    }
+
+    struct can_filter merged = zyphal_filter_merge(&slot_filters[a], &slot_filters[b]);
+    ret = rx_filter_install(inst, a, &merged);
+    if (ret < 0) { return ret; }
+
+    zyphal_sub_t* cur;
+    SYS_SLIST_FOR_EACH_CONTAINER(&inst->rx_subs, cur, node) {
+        if (cur->filter_slot == b) { cur->filter_slot = a; }
+    }
+    filters[a].members += filters[b].members;
+
+    ret = rx_filter_install(inst, b, &sub->filter);
+    if (ret < 0) {
+        rx_filter_uninstall(inst, &filters[b]);
+        filters[b].members = 0;
+        return ret;
+    }
+    sub->filter_slot = b;
+    filters[b].members = 1;
+    rx_filter_fold(inst, a);
+    return 0;
+}
+
+/* Releases a subscription's filter slot, narrowing it to the remaining members. The
+ * subscription must already be removed from the instance subscription list. */
+static void rx_filter_remove(zyphal_inst_t* inst, zyphal_sub_t* sub) {
+    zyphal_rx_filter_t* f = &inst->rx_filters[sub->filter_slot];
+
+    if (--f->members == 0) {
+        rx_filter_uninstall(inst, f);
+        return;
+    }
+
+    struct can_filter narrowed = {0};
+    bool first = true;
+    zyphal_sub_t* cur;
+    SYS_SLIST_FOR_EACH_CONTAINER(&inst->rx_subs, cur, node) {
+        if (cur->filter_slot != sub->filter_slot) { continue; }
+        narrowed = first ? cur->filter : zyphal_filter_merge(&narrowed, &cur->filter);
+        first = false;
+    }
+
+    if (narrowed.id != f->filter.id || narrowed.mask != f->filter.mask) {
+        (void)rx_filter_install(inst, sub->filter_slot, &narrowed);
+    }
+}
+
+static void rx_session_free(zyphal_inst_t* inst, uint8_t index) {
+    zyphal_rx_session_t* session = &inst->rx_sessions[index];
+
+    session->owner->sessions[session->source] = RX_SESSION_NONE;
+    session->owner = NULL;
+    session->next_free = inst->rx_free;
+    inst->rx_free = index;
+}
+
+/* Reclaims a session which has been idle for longer than the transfer ID timeout,
+ * only used once the pool is exhausted so the scan stays out of the common path. */
+static bool rx_session_reclaim(zyphal_inst_t* inst, int64_t now) {
+    for (uint8_t i = 0; i < CONFIG_ZYPHAL_RX_SESSIONS; i++) {
+        zyphal_rx_session_t* session = &inst->rx_sessions[i];
+        if (session->owner == NULL || session->active) { continue; }
+        if (now - session->timestamp > RX_TRANSFER_ID_TIMEOUT_TICKS) {
+            rx_session_free(inst, i);
+            return true;
+        }
+    }
+    return false;
+}
+
+static zyphal_rx_session_t* rx_session_get(zyphal_sub_t* sub,
+                                           uint8_t source,
+                                           int64_t now) {
+    zyphal_inst_t* inst = sub->inst;
+
+    uint8_t index = sub->sessions[source];
+    if (index != RX_SESSION_NONE) { return &inst->rx_sessions[index]; }
+
+    if (inst->rx_free == RX_SESSION_NONE && !rx_session_reclaim(inst, now)) {
+        return NULL;
+    }
+
+    index = inst->rx_free;
+    zyphal_rx_session_t* session = &inst->rx_sessions[index];
+    inst->rx_free = session->next_free;
+
+    session->owner = sub;
+    session->source = source;
+    session->active = 0;
+    session->received = 0;
+    /* Ensures the first transfer from a new source is never treated as a duplicate. */
+    session->timestamp = now - RX_TRANSFER_ID_TIMEOUT_TICKS - 1;
+    sub->sessions[source] = index;
+
+    return session;
+}
+
+static void rx_session_append(zyphal_sub_t* sub,
+                              zyphal_rx_session_t* session,
+                              const uint8_t* data,
+                              size_t len) {
+    session->crc = zyphal_crc16(session->crc, data, len);
+
+    size_t space = session->received < sub->extent ? sub->extent - session->received : 0;
+    size_t copy = MIN(len, space);
+    if (copy > 0) { memcpy(&session->payload[session->received], data, copy); }
+    session->received += len;
+}
+
+static void rx_accept_frame(zyphal_iface_t* iface,
+                            const struct can_frame* frame,
+                            uint8_t slot) {
+    zyphal_inst_t* inst = iface->inst;
+    if (!(frame->flags & CAN_FRAME_IDE) || (frame->flags & CAN_FRAME_RTR)) { return; }
+    size_t len = can_dlc_to_bytes(frame->dlc);
+    if (len < TAIL_BYTE_SIZE) { return; }
+
+    /* Merged hardware filters also pass frames of ports that are not subscribed, and
+     * service transfers addressed to other nodes. */
+    if (frame->id & CANID_RESERVED_ZERO_BIT) { return; }
+    bool service = (frame->id & CANID_SERVICE_BIT) != 0;
+    uint8_t kind = RX_KIND_MESSAGE;
+    uint16_t port_id = (frame->id & CANID_SUBJECT_ID_MASK) >> CANID_SUBJECT_ID_SHIFT;
+    if (service) {
+        uint8_t destination =
+            (frame->id & CANID_DESTINATION_ID_MASK) >> CANID_DESTINATION_ID_SHIFT;
+        if (destination != inst->node_id) { return; }
+        kind = (frame->id & CANID_REQUEST_BIT) ? RX_KIND_REQUEST : RX_KIND_RESPONSE;
+        port_id = (frame->id & CANID_SERVICE_ID_MASK) >> CANID_SERVICE_ID_SHIFT;
+    }
+    uint16_t port_key = rx_port_key(kind, port_id);
+
+    k_spinlock_key_t key = k_spin_lock(&inst->rx_lock);
+
+    /* Overlapping filter slots pass a frame once for each of them, it is only accepted
+     * from the slot of its subscription. */
+    zyphal_sub_t* sub = rx_port_lookup(inst, port_key);
+    if (sub == NULL || sub->filter_slot != slot) {
+        k_spin_unlock(&inst->rx_lock, key);
+        return;
+    }
+
+    uint8_t tail = frame->data[len - TAIL_BYTE_SIZE];
+    bool start = (tail & TAIL_START_BIT) != 0;
+    bool end = (tail & TAIL_END_BIT) != 0;
+    bool toggle = (tail & TAIL_TOGGLE_BIT) != 0;
+    uint8_t transfer_id = tail & TAIL_TRANSFER_ID_MASK;
+    size_t data_len = len - TAIL_BYTE_SIZE;
+    int64_t now = k_uptime_ticks();
+
+    zyphal_rx_transfer_t transfer = {
+        .priority = (zyphal_prio_t)((frame->id & CANID_PRIO_MASK) >> CANID_PRIO_SHIFT),
+        .port_id = sub->port_id,
+        .source_node_id = frame->id & CANID_SOURCE_ID_MASK,
+        .transfer_id = transfer_id,
+        .timestamp = now,
+    };
+
+    /* Anonymous transfers are always single frame messages, and have no session state,
+     * so they are delivered once from every interface. */
+    if (!service && (frame->id & CANID_MSG_ANONYMOUS_BIT)) {
+        k_spin_unlock(&inst->rx_lock, key);
+        if (!start || !end || !toggle) { return; }
+        transfer.source_node_id = ZYPHAL_NODE_ID_UNSET;
+        transfer.payload = frame->data;
+        transfer.payload_len = MIN(data_len, sub->extent);
+        sub->cb(&transfer, sub->user_data);
+        return;
+    }
+
+    zyphal_rx_session_t* session = rx_session_get(sub, transfer.source_node_id, now);
+    if (session == NULL) {
+        k_spin_unlock(&inst->rx_lock, key);
+        return;
+    }
+
+    /* A session follows a single redundant interface, so copies of a transfer arriving
+     * on the others are dropped here without being reassembled. It only moves to
+     * another interface once no transfer has started on its own for the transfer ID
+     * timeout. */
+    bool timed_out = now - session->timestamp > RX_TRANSFER_ID_TIMEOUT_TICKS;
+    if (iface->index != session->iface && !(start && timed_out)) {
+        k_spin_unlock(&inst->rx_lock, key);
+        return;
+    }
+
+    if (start) {
+        /* The first frame of every transfer carries a set toggle bit. A repeated
+         * transfer ID is only a new transfer once the transfer ID timeout elapses. */
+        if (!toggle || (transfer_id == session->transfer_id && !timed_out)) {
+            k_spin_unlock(&inst->rx_lock, key);
+            return;
+        }
+
+        session->iface = iface->index;
+        session->transfer_id = transfer_id;
+        session->timestamp = now;
+        session->active = 0;
+
+        if (end) {
+            k_spin_unlock(&inst->rx_lock, key);
+
+            /* Single frame transfers are delivered directly from the frame. */
+            transfer.payload = frame->data;
+            transfer.payload_len = MIN(data_len, sub->extent);
+            sub->cb(&transfer, sub->user_data);
+            return;
+        }
+
+        session->active = 1;
+        session->received = 0;
+        session->crc = UINT16_MAX;
+    } else if (!session->active || transfer_id != session->transfer_id ||
+               toggle != session->toggle) {
+        /* Missed or out of order frame, the transfer cannot be recovered. */
+        session->active = 0;
+        k_spin_unlock(&inst->rx_lock, key);
+        return;
+    }
+
+    rx_session_append(sub, session, frame->data, data_len);
+    session->toggle = !toggle;
+
+    if (!end) {
+        k_spin_unlock(&inst->rx_lock, key);
+        return;
+    }
+
+    /* Running the CRC over the payload including the transmitted CRC yields zero. */
+    session->active = 0;
+    if (session->crc != 0 || session->received < MULTI_FRAME_CRC_SIZE) {
+        k_spin_unlock(&inst->rx_lock, key);
+        return;
+    }
+
+    transfer.timestamp = session->timestamp;
+    transfer.payload = session->payload;
+    transfer.payload_len = MIN(session->received - MULTI_FRAME_CRC_SIZE, sub->extent);
+    k_spin_unlock(&inst->rx_lock, key);
+
+    sub->cb(&transfer, sub->user_data);
+}
+
+/* Copies a received frame into the ring of its interface, in constant time whatever
+ * the frame is. The driver calls this from its ISR, one frame at a time. */
+static void rx_frame_callback(const struct device* dev,
+                              struct can_frame* frame,
+                              void* user_data) {
+    zyphal_rx_filter_ref_t* ref = (zyphal_rx_filter_ref_t*)user_data;
+    zyphal_iface_t* iface = ref->iface;
+    uint32_t head = (uint32_t)atomic_get(&iface->rx_ring_head);
+    uint32_t tail = (uint32_t)atomic_get(&iface->rx_ring_tail);
+
+    if (head - tail >= CONFIG_ZYPHAL_RX_RING_DEPTH) {
+        atomic_inc(&iface->rx_ring_overflows);
+        return;
+    }
+
+    iface->rx_ring[head & RX_RING_MASK] = *frame;
+    iface->rx_ring_slots[head & RX_RING_MASK] = ref->slot;
+    atomic_set(&iface->rx_ring_head, (atomic_val_t)(head + 1));
+    k_work_submit_to_queue(zyphal_rx_workq(iface->inst), &iface->inst->rx_work);
+}
+
+/* Dispatches the frames waiting in the ring of an interface when called. Each slot is
+ * only released once its frame has been handled. Returns true if more frames arrived
+ * meanwhile. */
+static bool rx_ring_drain(zyphal_iface_t* iface) {
+    zyphal_inst_t* inst = iface->inst;
+    uint32_t tail = (uint32_t)atomic_get(&iface->rx_ring_tail);
+    uint32_t head = (uint32_t)atomic_get(&iface->rx_ring_head);
+
+    k_spinlock_key_t key = k_spin_lock(&inst->rx_lock);
+    inst->rx_stats.frames += head - tail;
+    inst->rx_stats.ring_max = MAX(inst->rx_stats.ring_max, head - tail);
+    k_spin_unlock(&inst->rx_lock, key);
+
+    for (; tail != head; tail++) {
+        rx_accept_frame(iface,
+                        &iface->rx_ring[tail & RX_RING_MASK],
+                        iface->rx_ring_slots[tail & RX_RING_MASK]);
+        atomic_set(&iface->rx_ring_tail, (atomic_val_t)(tail + 1));
+    }
+
+    return (uint32_t)atomic_get(&iface->rx_ring_head) != head;
+}
+
+/* Drains the rings of every interface a batch at a time, so a busy bus leaves room for
+ * the other work items of the queue. */
+static void rx_work_handler(struct k_work* work) {
+    zyphal_inst_t* inst = CONTAINER_OF(work, zyphal_inst_t, rx_work);
+
+    bool pending = false;
+    for (size_t i = 0; i < inst->iface_count; i++) {
+        pending |= rx_ring_drain(&inst->ifaces[i]);
+    }
+    if (pending) { k_work_submit_to_queue(zyphal_rx_workq(inst), &inst->rx_work); }
+}
+
+int32_t zyphal_rx_subscribe(zyphal_inst_t* inst,
+                            zyphal_sub_t* sub,
+                            uint8_t kind,
+                            uint16_t port_id,
+                            size_t extent,
+                            zyphal_rx_cb_t cb,
+                            void* user_data) {
+    if (!inst || !sub || !cb || extent > CONFIG_ZYPHAL_RX_EXTENT_MAX) { return -EINVAL; }
+
+    memset(sub, 0, sizeof(zyphal_sub_t));
+    sub->inst = inst;
+    sub->port_id = port_id;
+    sub->port_key = rx_port_key(kind, port_id);
+    sub->extent = extent;
+    sub->cb = cb;
+    sub->user_data = user_data;
+    memset(sub->sessions, RX_SESSION_NONE, sizeof(sub->sessions));
+
+    if (kind == RX_KIND_MESSAGE) {
+        /* Accept messages (service bit and reserved bit clear) on this subject from any
+         * source, anonymous or not. */
+        sub->filter = (struct can_filter){
+            .id = (uint32_t)port_id << CANID_SUBJECT_ID_SHIFT,
+            .mask = CANID_SERVICE_BIT | CANID_RESERVED_ZERO_BIT | CANID_SUBJECT_ID_MASK,
+            .flags = CAN_FILTER_IDE,
+        };
+    } else {
+        /* Accept requests or responses of this service addressed to this node, from any
+         * source. */
+        sub->filter = (struct can_filter){
+            .id = CANID_SERVICE_BIT | (kind == RX_KIND_REQUEST ? CANID_REQUEST_BIT : 0) |
+                  ((uint32_t)port_id << CANID_SERVICE_ID_SHIFT) |
+                  ((uint32_t)inst->node_id << CANID_DESTINATION_ID_SHIFT),
+            .mask = CANID_SERVICE_BIT | CANID_REQUEST_BIT | CANID_RESERVED_ZERO_BIT |
+                    CANID_SERVICE_ID_MASK | CANID_DESTINATION_ID_MASK,
+            .flags = CAN_FILTER_IDE,
+        };
+    }
+
+    int32_t ret = k_mutex_lock(&inst->mutex, K_FOREVER);
+    if (ret < 0) { return ret; }
+
+    if (rx_port_lookup(inst, sub->port_key) != NULL) {
+        ret = -EALREADY;
+        goto end;
+    } else if (sys_slist_len(&inst->rx_subs) >= CONFIG_ZYPHAL_RX_PORT_TABLE_SIZE - 1) {
+        ret = -ENOMEM;
+        goto end;
+    }
+
+    sys_slist_append(&inst->rx_subs, &sub->node);
+    ret = rx_filter_add(inst, sub);
+    if (ret < 0) {
+        sys_slist_find_and_remove(&inst->rx_subs, &sub->node);
+        goto end;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&inst->rx_lock);
+    rx_port_insert(inst, sub);
+    k_spin_unlock(&inst->rx_lock, key);
+
+end:
+    k_mutex_unlock(&inst->mutex);
+    return ret;
+}
+
+int32_t zyphal_rx_stats_get(zyphal_inst_t* inst, zyphal_rx_stats_t* stats) {
+    if (!inst || !stats) { return -EINVAL; }
+
+    k_spinlock_key_t key = k_spin_lock(&inst->rx_lock);
+    *stats = inst->rx_stats;
+    k_spin_unlock(&inst->rx_lock, key);
+
+    stats->ring_overflows = 0;
+    for (size_t i = 0; i < inst->iface_count; i++) {
+        stats->ring_overflows += atomic_get(&inst->ifaces[i].rx_ring_overflows);
+    }
+
+    return 0;
+}
+
+int32_t zyphal_subscribe(zyphal_inst_t* inst,
+                         zyphal_sub_t* sub,
+                         uint16_t subject_id,
+                         size_t extent,
+                         zyphal_rx_cb_t cb,
+                         void* user_data) {
+    if (subject_id > ZYPHAL_MAX_SUBJECT_ID) { return -EINVAL; }
+    return zyphal_rx_subscribe(
+        inst, sub, RX_KIND_MESSAGE, subject_id, extent, cb, user_data);
+}
+
+int32_t zyphal_serve(zyphal_inst_t* inst,
+                     zyphal_sub_t* sub,
+                     uint16_t service_id,
+                     size_t extent,
+                     zyphal_rx_cb_t cb,
+                     void* user_data) {
+    if (service_id > ZYPHAL_MAX_SERVICE_ID) { return -EINVAL; }
+    return zyphal_rx_subscribe(
+        inst, sub, RX_KIND_REQUEST, service_id, extent, cb, user_data);
+}
+
+int32_t zyphal_unsubscribe(zyphal_sub_t* sub) {
+    if (!sub || !sub->inst) { return -EINVAL; }
+    zyphal_inst_t* inst = sub->inst;
+
+    int32_t ret = k_mutex_lock(&inst->mutex, K_FOREVER);
+    if (ret < 0) { return ret; }
+
+    if (!sys_slist_find_and_remove(&inst->rx_subs, &sub->node)) {
+        ret = -EALREADY;
+        goto end;
+    }
+
+    /* Stop dispatching to the subscription, and return its sessions to the pool. */
+    k_spinlock_key_t key = k_spin_lock(&inst->rx_lock);
+    rx_port_remove(inst, sub);
+    for (size_t i = 0; i < ARRAY_SIZE(sub->sessions); i++) {
+        if (sub->sessions[i] != RX_SESSION_NONE) {
+            rx_session_free(inst, sub->sessions[i]);
+        }
+    }
+    k_spin_unlock(&inst->rx_lock, key);
+
+    rx_filter_remove(inst, sub);
+
+end:
+    k_mutex_unlock(&inst->mutex);
+
+    /* The receive work may have looked the subscription up before it was removed, and
+     * be about to call it. No work item of the queue runs while called from it. */
+    struct k_work_q* workq = zyphal_rx_workq(inst);
+    if (ret == 0 && k_current_get() != k_work_queue_thread_get(workq)) {
+        struct k_work_sync sync;
+        (void)k_work_flush(&inst->rx_work, &sync);
+    }
+
+    return ret;
+}
@@ -0,0 +1,28 @@
+#ifndef RECEIVE_H
+#define RECEIVE_H
+
+#include "zyphal/core.h"
+
+/* Kinds of transfers a subscription can receive. */
+#define RX_KIND_MESSAGE (0)
+#define RX_KIND_REQUEST (1)
+#define RX_KIND_RESPONSE (2)
+
+void zyphal_rx_init(zyphal_inst_t* inst);
+/* Starts the receive work queue of an instance, once on its first initialization. */
+void zyphal_rx_workq_start(zyphal_inst_t* inst);
+/* Work queue that the receive work and its callbacks run on. */
+struct k_work_q* zyphal_rx_workq(zyphal_inst_t* inst);
+/* Limits the receive filter plan to what the controller of an interface provides. */
+void zyphal_rx_iface_init(zyphal_iface_t* iface);
+/* Subscribes to transfers of a kind on a port. Service transfers are only accepted when
+ * addressed to the instance node ID. */
+int32_t zyphal_rx_subscribe(zyphal_inst_t* inst,
+                            zyphal_sub_t* sub,
+                            uint8_t kind,
+                            uint16_t port_id,
+                            size_t extent,
+                            zyphal_rx_cb_t cb,
+                            void* user_data);
+
+#endif /* RECEIVE_H */
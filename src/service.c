@@ -0,0 +1,361 @@
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/slist.h>
+
+LOG_MODULE_DECLARE(zyphal);
+
+#include "frame.h"
+#include "receive.h"
+#include "service.h"
+#include "transmit.h"
+#include "zyphal/core.h"
+
+#define RPC_PENDING_TABLE_MASK (CONFIG_ZYPHAL_RPC_PENDING_TABLE_SIZE - 1)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_ZYPHAL_RPC_PENDING_TABLE_SIZE));
+
+static uint32_t rpc_key(uint16_t service_id,
+                        uint8_t server_node_id,
+                        uint8_t transfer_id) {
+    return ((uint32_t)service_id << 12) | ((uint32_t)server_node_id << 5) | transfer_id;
+}
+
+static uint32_t rpc_request_key(const zyphal_request_t* req) {
+    return rpc_key(req->client->sub.port_id, req->server_node_id, req->transfer_id);
+}
+
+static size_t rpc_hash(uint32_t key) {
+    return ((key * 2654435761U) >> 16) & RPC_PENDING_TABLE_MASK;
+}
+
+static zyphal_request_t* rpc_pending_lookup(zyphal_inst_t* inst, uint32_t key) {
+    for (size_t i = rpc_hash(key);; i = (i + 1) & RPC_PENDING_TABLE_MASK) {
+        zyphal_request_t* req = inst->rpc_pending[i];
+        if (req == NULL || rpc_request_key(req) == key) { return req; }
+    }
+}
+
+static void rpc_pending_insert(zyphal_inst_t* inst, zyphal_request_t* req) {
+    size_t i = rpc_hash(rpc_request_key(req));
+    while (inst->rpc_pending[i] != NULL) { i = (i + 1) & RPC_PENDING_TABLE_MASK; }
+    inst->rpc_pending[i] = req;
+    inst->rpc_pending_count++;
+}
+
+static void rpc_pending_remove(zyphal_inst_t* inst, zyphal_request_t* req) {
+    size_t i = rpc_hash(rpc_request_key(req));
+    while (inst->rpc_pending[i] != req) { i = (i + 1) & RPC_PENDING_TABLE_MASK; }
+    inst->rpc_pending[i] = NULL;
+    inst->rpc_pending_count--;
+    req->pending = false;
+
+    /* Same backward shift as the receive port table, lookups stop at the first empty
+     * slot. */
+    for (size_t j = (i + 1) & RPC_PENDING_TABLE_MASK; inst->rpc_pending[j] != NULL;
+         j = (j + 1) & RPC_PENDING_TABLE_MASK) {
+        size_t home = rpc_hash(rpc_request_key(inst->rpc_pending[j]));
+        bool reachable = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!reachable) {
+            inst->rpc_pending[i] = inst->rpc_pending[j];
+            inst->rpc_pending[j] = NULL;
+            i = j;
+        }
+    }
+}
+
+/* Removes every pending request accepted by match into a list, so they can be completed
+ * outside of the lock. Returns the earliest deadline of the requests left pending. */
+static k_timepoint_t rpc_pending_collect(zyphal_inst_t* inst,
+                                         bool (*match)(zyphal_request_t* req, void* arg),
+                                         void* arg,
+                                         sys_slist_t* list) {
+    k_timepoint_t next = sys_timepoint_calc(K_FOREVER);
+
+    /* Removal may shift later entries back into the current slot, so it is revisited. */
+    for (size_t i = 0; i < CONFIG_ZYPHAL_RPC_PENDING_TABLE_SIZE;) {
+        zyphal_request_t* req = inst->rpc_pending[i];
+        if (req != NULL && match(req, arg)) {
+            rpc_pending_remove(inst, req);
+            sys_slist_append(list, &req->node);
+            continue;
+        }
+        if (req != NULL && sys_timepoint_cmp(req->deadline, next) < 0) {
+            next = req->deadline;
+        }
+        i++;
+    }
+
+    return next;
+}
+
+static void rpc_complete_list(sys_slist_t* list, int32_t status) {
+    zyphal_request_t* req;
+    zyphal_request_t* next;
+    SYS_SLIST_FOR_EACH_CONTAINER_SAFE (list, req, next, node) {
+        /* The request transfer may still be queued if it shares the deadline, it must
+         * not be sent once the request has completed. */
+        (void)zyphal_tx_cancel_timeout(&req->tx, K_FOREVER);
+        req->cb(NULL, status, req->user_data);
+    }
+}
+
+static bool rpc_match_expired(zyphal_request_t* req, void* arg) {
+    ARG_UNUSED(arg);
+    return sys_timepoint_expired(req->deadline);
+}
+
+static void rpc_work_handler(struct k_work* work) {
+    struct k_work_delayable* dwork = k_work_delayable_from_work(work);
+    zyphal_inst_t* inst = CONTAINER_OF(dwork, zyphal_inst_t, rpc_work);
+
+    sys_slist_t expired;
+    sys_slist_init(&expired);
+
+    k_spinlock_key_t key = k_spin_lock(&inst->rpc_lock);
+    inst->rpc_next_deadline =
+        rpc_pending_collect(inst, rpc_match_expired, NULL, &expired);
+    k_timeout_t next = sys_timepoint_timeout(inst->rpc_next_deadline);
+    k_spin_unlock(&inst->rpc_lock, key);
+
+    if (!K_TIMEOUT_EQ(next, K_FOREVER)) {
+        k_work_reschedule_for_queue(zyphal_tx_workq(inst), &inst->rpc_work, next);
+    }
+    rpc_complete_list(&expired, -ETIMEDOUT);
+}
+
+static void rpc_tx_done_cb(void* user_data, int32_t status) {
+    zyphal_request_t* req = (zyphal_request_t*)user_data;
+    zyphal_inst_t* inst = req->tx.inst;
+
+    /* Once sent, the request stays pending until the response or the deadline. */
+    if (status == 0) { return; }
+
+    k_spinlock_key_t key = k_spin_lock(&inst->rpc_lock);
+    bool pending = req->pending;
+    if (pending) { rpc_pending_remove(inst, req); }
+    k_spin_unlock(&inst->rpc_lock, key);
+
+    if (pending) { req->cb(NULL, status, req->user_data); }
+}
+
+static void rpc_response_cb(const zyphal_rx_transfer_t* transfer, void* user_data) {
+    zyphal_client_t* client = (zyphal_client_t*)user_data;
+    zyphal_inst_t* inst = client->sub.inst;
+
+    k_spinlock_key_t key = k_spin_lock(&inst->rpc_lock);
+    uint32_t req_key =
+        rpc_key(client->sub.port_id, transfer->source_node_id, transfer->transfer_id);
+    zyphal_request_t* req = rpc_pending_lookup(inst, req_key);
+    if (req != NULL) { rpc_pending_remove(inst, req); }
+    k_spin_unlock(&inst->rpc_lock, key);
+
+    /* Responses without a pending request are late, or duplicates. */
+    if (req != NULL) { req->cb(transfer, 0, req->user_data); }
+}
+
+void zyphal_rpc_init(zyphal_inst_t* inst) {
+    memset(inst->rpc_pending, 0, sizeof(inst->rpc_pending));
+    inst->rpc_pending_count = 0;
+    inst->rpc_next_deadline = sys_timepoint_calc(K_FOREVER);
+    k_work_init_delayable(&inst->rpc_work, rpc_work_handler);
+}
+
+int32_t zyphal_respond(zyphal_tx_t* tx,
+                       zyphal_prio_t priority,
+                       uint16_t service_id,
+                       uint8_t client_node_id,
+                       uint8_t transfer_id,
+                       uint8_t* payload,
+                       size_t len,
+                       k_timeout_t timeout,
+                       zyphal_tx_done_cb_t cb,
+                       void* user_data) {
+    if (!tx || priority > ZYPHAL_PRIO_OPTIONAL || service_id > ZYPHAL_MAX_SERVICE_ID ||
+        client_node_id > ZYPHAL_MAX_NODE_ID) {
+        return -EINVAL;
+    }
+
+    uint32_t id = make_canid(
+        priority, true, false, service_id, 0, client_node_id, tx->inst->node_id);
+    zyphal_iov_t iov = {.data = payload, .len = len};
+    return zyphal_tx_start(tx,
+                           id,
+                           transfer_id & TAIL_TRANSFER_ID_MASK,
+                           &iov,
+                           1,
+                           timeout,
+                           cb,
+                           user_data);
+}
+
+int32_t zyphal_respond_source(zyphal_tx_t* tx,
+                              zyphal_prio_t priority,
+                              uint16_t service_id,
+                              uint8_t client_node_id,
+                              uint8_t transfer_id,
+                              size_t len,
+                              zyphal_tx_source_cb_t source,
+                              void* source_user_data,
+                              k_timeout_t timeout,
+                              zyphal_tx_done_cb_t cb,
+                              void* user_data) {
+    if (!tx || priority > ZYPHAL_PRIO_OPTIONAL || service_id > ZYPHAL_MAX_SERVICE_ID ||
+        client_node_id > ZYPHAL_MAX_NODE_ID) {
+        return -EINVAL;
+    }
+
+    uint32_t id = make_canid(
+        priority, true, false, service_id, 0, client_node_id, tx->inst->node_id);
+    return zyphal_tx_start_source(tx,
+                                  id,
+                                  transfer_id & TAIL_TRANSFER_ID_MASK,
+                                  len,
+                                  source,
+                                  source_user_data,
+                                  timeout,
+                                  cb,
+                                  user_data);
+}
+
+int32_t zyphal_client_init(zyphal_inst_t* inst,
+                           zyphal_client_t* client,
+                           uint16_t service_id,
+                           size_t extent) {
+    if (!client || service_id > ZYPHAL_MAX_SERVICE_ID) { return -EINVAL; }
+
+    client->transfer_id = 0;
+    return zyphal_rx_subscribe(inst,
+                               &client->sub,
+                               RX_KIND_RESPONSE,
+                               service_id,
+                               extent,
+                               rpc_response_cb,
+                               client);
+}
+
+static bool rpc_match_client(zyphal_request_t* req, void* arg) {
+    return req->client == (zyphal_client_t*)arg;
+}
+
+int32_t zyphal_client_deinit(zyphal_client_t* client) {
+    if (!client) { return -EINVAL; }
+    zyphal_inst_t* inst = client->sub.inst;
+
+    int32_t ret = zyphal_unsubscribe(&client->sub);
+    if (ret < 0) { return ret; }
+
+    sys_slist_t canceled;
+    sys_slist_init(&canceled);
+
+    k_spinlock_key_t key = k_spin_lock(&inst->rpc_lock);
+    rpc_pending_collect(inst, rpc_match_client, client, &canceled);
+    k_spin_unlock(&inst->rpc_lock, key);
+
+    rpc_complete_list(&canceled, -ECANCELED);
+    return 0;
+}
+
+int32_t zyphal_request_init(zyphal_client_t* client, zyphal_request_t* req) {
+    if (!client || !req) { return -EINVAL; }
+
+    memset(req, 0, sizeof(zyphal_request_t));
+    req->client = client;
+    return zyphal_tx_init(client->sub.inst, &req->tx);
+}
+
+int32_t zyphal_request(zyphal_request_t* req,
+                       zyphal_prio_t priority,
+                       uint8_t server_node_id,
+                       uint8_t* payload,
+                       size_t len,
+                       k_timeout_t timeout,
+                       zyphal_response_cb_t cb,
+                       void* user_data) {
+    if (!req || !req->client || !cb || priority > ZYPHAL_PRIO_OPTIONAL ||
+        server_node_id > ZYPHAL_MAX_NODE_ID) {
+        return -EINVAL;
+    }
+    zyphal_client_t* client = req->client;
+    zyphal_inst_t* inst = client->sub.inst;
+
+    /* The previous request may have completed with its final frame still in flight. */
+    if (req->pending || zyphal_tx_pending(&req->tx)) { return -EALREADY; }
+
+    int32_t ret = 0;
+    bool reschedule = false;
+    uint32_t id = make_canid(
+        priority, true, true, client->sub.port_id, 0, server_node_id, inst->node_id);
+    k_spinlock_key_t key = k_spin_lock(&inst->rpc_lock);
+
+    /* Requests continue the transfer IDs of the instance session of the service and
+     * server, or those of the client if the session table is full. Either only
+     * advances here under the lock once the ID is known to be free. Keep one slot of
+     * the pending table empty, so lookups always terminate. */
+    int16_t transfer_id = zyphal_tx_session_next(inst, id, false);
+    bool session = transfer_id >= 0;
+    if (!session) { transfer_id = client->transfer_id; }
+    if (inst->rpc_pending_count >= CONFIG_ZYPHAL_RPC_PENDING_TABLE_SIZE - 1) {
+        ret = -ENOMEM;
+        goto end;
+    } else if (rpc_pending_lookup(
+                   inst, rpc_key(client->sub.port_id, server_node_id, transfer_id))) {
+        /* Every transfer ID to this server is still awaiting a response. */
+        ret = -EBUSY;
+        goto end;
+    }
+
+    if (session) {
+        (void)zyphal_tx_session_next(inst, id, true);
+    } else {
+        client->transfer_id = (transfer_id + 1) & TAIL_TRANSFER_ID_MASK;
+    }
+    req->server_node_id = server_node_id;
+    req->transfer_id = transfer_id;
+    req->deadline = sys_timepoint_calc(timeout);
+    req->cb = cb;
+    req->user_data = user_data;
+    req->pending = true;
+    rpc_pending_insert(inst, req);
+
+    if (sys_timepoint_cmp(req->deadline, inst->rpc_next_deadline) < 0) {
+        inst->rpc_next_deadline = req->deadline;
+        reschedule = true;
+    }
+
+end:
+    k_spin_unlock(&inst->rpc_lock, key);
+    if (ret < 0) { return ret; }
+
+    if (reschedule) {
+        k_work_reschedule_for_queue(zyphal_tx_workq(inst), &inst->rpc_work, timeout);
+    }
+
+    /* Pending before sending, as the response may arrive before this returns. */
+    zyphal_iov_t iov = {.data = payload, .len = len};
+    ret = zyphal_tx_start(
+        &req->tx, id, transfer_id, &iov, 1, timeout, rpc_tx_done_cb, req);
+    if (ret < 0) {
+        key = k_spin_lock(&inst->rpc_lock);
+        if (req->pending) { rpc_pending_remove(inst, req); }
+        k_spin_unlock(&inst->rpc_lock, key);
+    }
+
+    return ret;
+}
+
+int32_t zyphal_request_cancel(zyphal_request_t* req) {
+    if (!req || !req->client) { return -EINVAL; }
+    zyphal_inst_t* inst = req->client->sub.inst;
+
+    k_spinlock_key_t key = k_spin_lock(&inst->rpc_lock);
+    bool pending = req->pending;
+    if (pending) { rpc_pending_remove(inst, req); }
+    k_spin_unlock(&inst->rpc_lock, key);
+
+    if (!pending) { return -EALREADY; }
+
+    (void)zyphal_tx_cancel_timeout(&req->tx, K_FOREVER);
+    req->cb(NULL, -ECANCELED, req->user_data);
+    return 0;
+}
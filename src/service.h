@@ -0,0 +1,9 @@
+#ifndef SERVICE_H
+#define SERVICE_H
+
+#include "zyphal/core.h"
+
+/* Initializes the pending request table of an instance. */
+void zyphal_rpc_init(zyphal_inst_t* inst);
+
+#endif /* SERVICE_H */
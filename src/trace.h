@@ -0,0 +1,23 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "zyphal/core.h"
+
+/* Transmit statistics updates, must be called with the instance mutex held. Compiled
+ * out without CONFIG_ZYPHAL_TX_STATS. */
+#if defined(CONFIG_ZYPHAL_TX_STATS)
+#define TX_STATS_INC(inst, field) ((inst)->tx_stats.field++)
+#define TX_STATS_ADD(inst, field, n) ((inst)->tx_stats.field += (n))
+#else
+#define TX_STATS_INC(inst, field)
+#define TX_STATS_ADD(inst, field, n)
+#endif
+
+/* Calls an application tracing hook, compiled out without CONFIG_ZYPHAL_TRACING. */
+#if defined(CONFIG_ZYPHAL_TRACING)
+#define ZYPHAL_TRACE(hook, ...) zyphal_trace_##hook(__VA_ARGS__)
+#else
+#define ZYPHAL_TRACE(hook, ...)
+#endif
+
+#endif /* TRACE_H */
@@ -1,60 +1,20 @@
+#include <stddef.h>
 #include <stdint.h>
 #include <zephyr/drivers/can.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/atomic.h>
-#include <zephyr/sys/crc.h>
-#include <zephyr/sys/slist.h>
 
 LOG_MODULE_DECLARE(zyphal);
 
+#include "admission.h"
+#include "crc.h"
+#include "frame.h"
+#include "trace.h"
+#include "transmit.h"
+#include "tx_queue.h"
 #include "zyphal/core.h"
 
-#define ZYPHAL_FRAME_MTU COND_CODE_1(CONFIG_ZYPHAL_CAN_FD, (64), (8))
-
-#define CANID_PRIO_SHIFT (26)
-#define CANID_PRIO_MASK GENMASK(28, 26)
-#define CANID_SERVICE_BIT BIT(25)
-#define CANID_REQUEST_BIT BIT(24)
-#define CANID_MSG_RESERVED_BITS (BIT(22) | BIT(21))
-#define CANID_SERVICE_ID_SHIFT (14)
-#define CANID_SERVICE_ID_MASK GENMASK(22, 14)
-#define CANID_SUBJECT_ID_SHIFT (8)
-#define CANID_SUBJECT_ID_MASK GENMASK(20, 8)
-#define CANID_DESTINATION_ID_SHIFT (7)
-#define CANID_DESTINATION_ID_MASK GENMASK(13, 7)
-#define CANID_SOURCE_ID_MASK GENMASK(6, 0)
-
-#define TAIL_START_BIT BIT(7)
-#define TAIL_END_BIT BIT(6)
-#define TAIL_TOGGLE_BIT BIT(5)
-#define TAIL_TRANSFER_ID_MASK GENMASK(4, 0)
-
-#define TAIL_BYTE_SIZE (1)
-#define MULTI_FRAME_CRC_SIZE (2)
-
-static uint32_t make_canid(uint8_t priority,
-                           bool is_service,
-                           bool is_request,
-                           uint16_t service_id,
-                           uint16_t subject_id,
-                           uint8_t destination_id,
-                           uint8_t source_id) {
-    uint32_t canid = (priority << CANID_PRIO_SHIFT) & CANID_PRIO_MASK;
-    if (is_service) {
-        canid |= CANID_SERVICE_BIT;
-        canid |= is_request ? CANID_REQUEST_BIT : 0;
-        canid |= (service_id << CANID_SERVICE_ID_SHIFT) & CANID_SERVICE_ID_MASK;
-        canid |=
-            (destination_id << CANID_DESTINATION_ID_SHIFT) & CANID_DESTINATION_ID_MASK;
-    } else {
-        canid |= CANID_MSG_RESERVED_BITS;
-        canid |= (subject_id << CANID_SUBJECT_ID_SHIFT) & CANID_SUBJECT_ID_MASK;
-    }
-    canid |= source_id & CANID_SOURCE_ID_MASK;
-    return canid;
-}
-
 static uint8_t make_tail_byte(bool start, bool end, bool toggle, uint8_t transfer_id) {
     return (transfer_id & TAIL_TRANSFER_ID_MASK) | (start ? TAIL_START_BIT : 0) |
            (end ? TAIL_END_BIT : 0) | (toggle ? TAIL_TOGGLE_BIT : 0);
@@ -64,161 +24,499 @@ struct built_frame {
     struct can_frame frame;
     size_t payload_len;
     uint8_t crc_len;
+    /* Transfer CRC and payload fragment cursor after this frame, only committed once the
+     * frame has been accepted by the driver so a rejected frame can be rebuilt. */
+    uint16_t crc;
+    bool crc_folded;
+    size_t iov_index;
+    size_t iov_offset;
+    /* Error of the payload source, the frame is not sent. */
+    int32_t status;
 };
 
-static struct built_frame build_next_frame(zyphal_tx_t* tx) {
-    bool start = tx->payload_written == 0;
-    bool end = atomic_get(&tx->pending) == 1;
-    bool single = start && end;
-    size_t payload_remaining = tx->payload_len - tx->payload_written;
+/* Copies payload from the fragments at the cursor of the frame, advancing the cursor. */
+static void copy_payload(zyphal_tx_t* tx, struct built_frame* out) {
+    size_t copied = 0;
+    while (copied < out->payload_len) {
+        const zyphal_iov_t* iov = &tx->iov[out->iov_index];
+        size_t len = MIN(iov->len - out->iov_offset, out->payload_len - copied);
+
+        if (len > 0) {
+            memcpy(&out->frame.data[copied], &iov->data[out->iov_offset], len);
+        }
+        copied += len;
+        out->iov_offset += len;
+        if (out->iov_offset == iov->len) {
+            out->iov_index++;
+            out->iov_offset = 0;
+        }
+    }
+}
+
+/* Fetches the payload of the frame from the payload source of the transfer. */
+static int32_t fetch_payload(zyphal_tx_t* tx,
+                             const zyphal_tx_cursor_t* cursor,
+                             struct built_frame* out) {
+    int32_t ret = tx->source(
+        tx->source_user_data, cursor->payload_written, out->frame.data, out->payload_len);
+
+    /* A source error must not read as full mailboxes, which retry the frame. */
+    if (ret == -EAGAIN || (ret >= 0 && (size_t)ret != out->payload_len)) { return -EIO; }
+    return ret < 0 ? ret : 0;
+}
+
+static struct built_frame build_next_frame(zyphal_tx_t* tx, zyphal_tx_cursor_t* cursor) {
+    bool start = cursor->frame == 0;
+    bool end = cursor->frame + 1 == tx->frames;
+    bool single = tx->frames == 1;
+    size_t payload_remaining = tx->payload_len - cursor->payload_written;
 
     struct built_frame out;
     memset(&out, 0, sizeof(out));
-
-    /* Write as much payload data as frame space allows. */
+    out.crc = tx->crc;
+    out.iov_index = cursor->iov_index;
+    out.iov_offset = cursor->iov_offset;
+    /* Only the first interface to build a frame runs it through the crc. Frames carrying
+     * crc bytes follow the last payload byte, so interfaces behind it already find the
+     * final crc. */
+    out.crc_folded = !single && cursor->frame == tx->crc_frames;
+
+    /* Write as much payload data as frame space allows, straight from the fragments or
+     * the source. */
     out.payload_len = MIN(payload_remaining, (ZYPHAL_FRAME_MTU - TAIL_BYTE_SIZE));
     if (out.payload_len > 0) {
-        memcpy(out.frame.data, &tx->payload[tx->payload_written], out.payload_len);
-        if (!single) {
-            tx->crc =
-                crc16_itu_t(tx->crc, &tx->payload[tx->payload_written], out.payload_len);
+        if (tx->source) {
+            out.status = fetch_payload(tx, cursor, &out);
+            if (out.status < 0) { return out; }
+        } else {
+            copy_payload(tx, &out);
+        }
+        if (out.crc_folded) {
+            out.crc = zyphal_crc16(out.crc, out.frame.data, out.payload_len);
         }
     }
 
     /* Calculate how much CRC can be written into the frame, before padding length.
      * Padding will only be added if the full CRC fits. */
-    size_t crc_remaining = single ? 0 : MULTI_FRAME_CRC_SIZE - tx->crc_written;
+    size_t crc_remaining = single ? 0 : MULTI_FRAME_CRC_SIZE - cursor->crc_written;
     size_t crc_space = (ZYPHAL_FRAME_MTU - TAIL_BYTE_SIZE) - out.payload_len;
     out.crc_len = MIN(crc_remaining, crc_space);
 
     /* Padding is only added on the last frame, if there is space in between the message
      * size (with CRC if applicable) and the next largest DLC size. */
-    size_t frame_dlc = can_bytes_to_dlc(out.payload_len + out.crc_len + TAIL_BYTE_SIZE);
+    uint8_t frame_dlc = frame_len_to_dlc(out.payload_len + out.crc_len + TAIL_BYTE_SIZE);
     size_t padding_len =
-        can_dlc_to_bytes(frame_dlc) - (out.payload_len + out.crc_len + TAIL_BYTE_SIZE);
+        frame_dlc_to_len(frame_dlc) - (out.payload_len + out.crc_len + TAIL_BYTE_SIZE);
     if (padding_len > 0) {
         memset(&out.frame.data[out.payload_len], 0, padding_len);
-        if (!single) {
-            tx->crc = crc16_itu_t(tx->crc, &out.frame.data[out.payload_len], padding_len);
+        if (out.crc_folded) {
+            out.crc =
+                zyphal_crc16(out.crc, &out.frame.data[out.payload_len], padding_len);
         }
     }
 
     /* Write as many crc bytes as will fit. */
     for (int i = 0; i < out.crc_len; i++) {
         uint8_t crc_byte =
-            (tx->crc_written + i == 0) ? (uint8_t)(tx->crc >> 8) : (uint8_t)tx->crc;
+            (cursor->crc_written + i == 0) ? (uint8_t)(out.crc >> 8) : (uint8_t)out.crc;
         out.frame.data[out.payload_len + padding_len + i] = crc_byte;
     }
 
     /* Write tail byte. */
-    uint8_t tail = make_tail_byte(start, end, tx->toggle, tx->transfer_id);
+    uint8_t tail = make_tail_byte(start, end, cursor->toggle, tx->transfer_id);
     out.frame.data[out.payload_len + padding_len + out.crc_len] = tail;
 
     out.frame.id = tx->id;
     out.frame.flags =
         CAN_FRAME_IDE |
         COND_CODE_1(CONFIG_ZYPHAL_CAN_FD, (CAN_FRAME_FDF | CAN_FRAME_BRS), (0));
-    out.frame.dlc =
-        can_bytes_to_dlc(out.payload_len + padding_len + out.crc_len + TAIL_BYTE_SIZE);
+    out.frame.dlc = frame_dlc;
 
     return out;
 }
 
-static void tx_queue_push(zyphal_inst_t* inst, zyphal_tx_t* tx) {
-    zyphal_tx_t* prev = NULL;
-    zyphal_tx_t* cur;
+void zyphal_tx_build_single(const zyphal_tx_t* tx, struct can_frame* frame) {
+    size_t len = tx->payload_len;
+    uint8_t dlc = frame_len_to_dlc(len + TAIL_BYTE_SIZE);
+    size_t size = frame_dlc_to_len(dlc);
 
-    SYS_SLIST_FOR_EACH_CONTAINER(&inst->tx_queue, cur, node) {
-        if (tx->id < cur->id) { break; }
-        prev = cur;
+    /* Only the header is cleared, every data byte up to the DLC is written below. */
+    memset(frame, 0, offsetof(struct can_frame, data));
+    frame->id = tx->id;
+    frame->flags =
+        CAN_FRAME_IDE |
+        COND_CODE_1(CONFIG_ZYPHAL_CAN_FD, (CAN_FRAME_FDF | CAN_FRAME_BRS), (0));
+    frame->dlc = dlc;
+
+    size_t copied = 0;
+    for (const zyphal_iov_t* iov = tx->iov; copied < len; iov++) {
+        if (iov->len > 0) {
+            memcpy(&frame->data[copied], iov->data, iov->len);
+            copied += iov->len;
+        }
+    }
+    if (size - TAIL_BYTE_SIZE > len) {
+        memset(&frame->data[len], 0, size - TAIL_BYTE_SIZE - len);
     }
+    uint8_t tail = make_tail_byte(true, true, true, tx->transfer_id);
+    frame->data[size - TAIL_BYTE_SIZE] = tail;
+}
 
-    if (prev == NULL) {
-        sys_slist_prepend(&inst->tx_queue, &tx->node);
-    } else {
-        sys_slist_insert(&inst->tx_queue, &prev->node, &tx->node);
+/* Builds the only frame of a transfer, which carries no crc and leaves the fragment
+ * cursor unused. */
+static struct built_frame build_single_frame(zyphal_tx_t* tx) {
+    struct built_frame out;
+    zyphal_tx_build_single(tx, &out.frame);
+    out.payload_len = tx->payload_len;
+    out.crc_len = 0;
+    out.crc = tx->crc;
+    out.crc_folded = false;
+    out.iov_index = 0;
+    out.iov_offset = 0;
+    out.status = 0;
+
+    return out;
+}
+
+/* Replays a frame of the previous transfer, only the transfer ID in the tail byte
+ * differs. */
+static struct built_frame build_cached_frame(zyphal_tx_t* tx,
+                                            zyphal_tx_cursor_t* cursor) {
+    struct built_frame out = {.frame = tx->cache[cursor->frame]};
+
+    uint8_t* tail = &out.frame.data[can_dlc_to_bytes(out.frame.dlc) - TAIL_BYTE_SIZE];
+    *tail = (*tail & ~TAIL_TRANSFER_ID_MASK) | tx->transfer_id;
+
+    return out;
+}
+
+/* Removes a transfer from the queue of an interface. A frame still held by the driver
+ * no longer refers to this transfer, the slot is released once the driver completes
+ * it. */
+static void tx_iface_drop(zyphal_iface_t* iface, zyphal_tx_t* tx) {
+    zyphal_tx_cursor_t* cursor = &tx->cursors[iface->index];
+
+    zyphal_tx_queue_remove(iface, tx);
+    zyphal_tx_backlog_remove(iface, tx);
+    if (cursor->in_flight) {
+        for (size_t i = 0; i < ARRAY_SIZE(iface->tx_slots); i++) {
+            if (iface->tx_slots[i].tx == tx) { iface->tx_slots[i].tx = NULL; }
+        }
+        cursor->in_flight = 0;
     }
+    cursor->done = 1;
 }
 
-static void tx_queue_remove(zyphal_inst_t* inst, zyphal_tx_t* tx, int32_t status) {
-    if (k_mutex_lock(&inst->mutex, K_NO_WAIT) < 0) { return; }
+#if defined(CONFIG_ZYPHAL_TX_STATS)
+static void tx_stats_complete(zyphal_inst_t* inst, zyphal_tx_t* tx, int32_t status) {
+    zyphal_tx_stats_t* stats = &inst->tx_stats;
+
+    stats->depth--;
+    if (status == -ETIMEDOUT) {
+        stats->expired++;
+    } else if (status == -ECANCELED) {
+        stats->canceled++;
+    } else if (status < 0) {
+        stats->failed++;
+    } else {
+        stats->completed++;
 
-    sys_slist_find_and_remove(&inst->tx_queue, &tx->node);
+        uint64_t us64 = k_ticks_to_us_floor64(k_uptime_ticks() - tx->start_ticks);
+        uint32_t us = (uint32_t)MIN(us64, UINT32_MAX);
+        size_t bucket = us < 2 ? 0 : find_msb_set(us) - 1;
+        stats->latency_us[MIN(bucket, ARRAY_SIZE(stats->latency_us) - 1)]++;
+        stats->latency_max_us = MAX(stats->latency_max_us, us);
+    }
+}
+#endif
 
-    bool expired = sys_timepoint_expired(tx->end);
-    bool pending = atomic_get(&tx->pending) > 0;
-    if (expired && pending && status == 0) { status = -ETIMEDOUT; }
+/* Removes a transfer from every interface and reports its status. Must be called with
+ * the instance mutex held. */
+static void tx_complete(zyphal_inst_t* inst, zyphal_tx_t* tx, int32_t status) {
+    for (size_t i = 0; i < inst->iface_count; i++) {
+        if (!tx->cursors[i].done) { tx_iface_drop(&inst->ifaces[i], tx); }
+    }
+    zyphal_tx_deadline_remove(inst, tx);
+#if defined(CONFIG_ZYPHAL_TX_STATS)
+    tx_stats_complete(inst, tx, status);
+#endif
+    ZYPHAL_TRACE(tx_done, tx, status);
+
+    /* The transmitter can be claimed by another publish as soon as it is no longer
+     * pending, which may replace the callback of this transfer. */
+    zyphal_tx_done_cb_t done_cb = tx->done_cb;
+    void* done_user_data = tx->done_user_data;
     atomic_clear(&tx->pending);
 
-    if (tx->done_cb) { tx->done_cb(tx->done_user_data, status); }
-    k_mutex_unlock(&inst->mutex);
+    if (done_cb) { done_cb(done_user_data, status); }
 }
 
-static zyphal_tx_t* tx_queue_get_next(zyphal_inst_t* inst) {
-    while (!sys_slist_is_empty(&inst->tx_queue)) {
-        zyphal_tx_t* tx = SYS_SLIST_PEEK_HEAD_CONTAINER(&inst->tx_queue, tx, node);
+/* Finishes a transfer on one interface, completing it once the instance policy is
+ * satisfied. Must be called with the instance mutex held. */
+static void tx_iface_done(zyphal_iface_t* iface, zyphal_tx_t* tx, int32_t status) {
+    zyphal_inst_t* inst = iface->inst;
+
+    tx_iface_drop(iface, tx);
+    if (status < 0 && tx->status == 0) { tx->status = status; }
+
+    /* A success under the first policy, or a failure under the all policy, decides the
+     * transfer without waiting for the other interfaces. */
+    bool decided = (status == 0) == (inst->tx_policy == ZYPHAL_TX_POLICY_FIRST);
+    if (decided || inst->iface_count == 1) {
+        /* A single interface always decides, without touching the pending count. */
+        tx_complete(inst, tx, status);
+    } else if (atomic_dec(&tx->pending) <= 1) {
+        tx_complete(inst, tx, tx->status);
+    }
+}
 
-        bool expired = sys_timepoint_expired(tx->end);
-        bool pending = atomic_get(&tx->pending) > 0;
-        if (!expired && pending) { return tx; }
+static zyphal_tx_t* tx_queue_get_next(zyphal_iface_t* iface) {
+    zyphal_tx_t* tx;
+    while ((tx = zyphal_tx_queue_peek_ready(iface)) != NULL) {
+        if (!sys_timepoint_expired(tx->end)) { return tx; }
 
-        tx_queue_remove(inst, tx, 0);
+        tx_iface_done(iface, tx, -ETIMEDOUT);
     }
 
     return NULL;
 }
 
-void can_send_callback(const struct device* dev, int error, void* user_data) {
-    zyphal_tx_t* tx = (zyphal_tx_t*)user_data;
-    atomic_val_t old = atomic_dec(&tx->pending);
+struct k_work_q* zyphal_tx_workq(zyphal_inst_t* inst) {
+    return COND_CODE_1(CONFIG_ZYPHAL_TX_WORKQ, (&inst->tx_workq), (&k_sys_work_q));
+}
 
-    if (error != 0 || old <= 1) { tx_queue_remove(tx->inst, tx, error); }
+/* Schedules the expiry work for the earliest queued deadline. A later deadline leaves
+ * the work as is, it runs early and schedules itself again. Must be called with the
+ * instance mutex held. */
+static void tx_expiry_schedule(zyphal_inst_t* inst) {
+    zyphal_tx_t* tx = zyphal_tx_deadline_peek(inst);
+    if (tx == NULL || sys_timepoint_cmp(tx->end, inst->tx_expiry_next) >= 0) { return; }
 
-    k_work_schedule(&tx->inst->tx_work, K_NO_WAIT);
+    inst->tx_expiry_next = tx->end;
+    k_work_reschedule_for_queue(
+        zyphal_tx_workq(inst), &inst->tx_expiry_work, sys_timepoint_timeout(tx->end));
 }
 
-void zyphal_tx_work_handler(struct k_work* work) {
-    struct k_work_delayable* dwork = k_work_delayable_from_work(work);
-    zyphal_inst_t* inst = CONTAINER_OF(dwork, zyphal_inst_t, tx_work);
+static void can_send_callback(const struct device* dev, int error, void* user_data) {
+    zyphal_tx_slot_t* slot = (zyphal_tx_slot_t*)user_data;
+    zyphal_iface_t* iface = slot->iface;
+    zyphal_inst_t* inst = iface->inst;
+
+    /* Only mark the slot as done, the transfer is advanced from the work handler. */
+    slot->status = error;
+    atomic_set_bit(iface->tx_slots_done, slot - iface->tx_slots);
+    /* A mailbox has been freed, resume immediately even if a busy retry is pending. */
+    k_work_reschedule_for_queue(zyphal_tx_workq(inst), &inst->tx_work, K_NO_WAIT);
+}
+
+static void tx_slots_reap(zyphal_iface_t* iface) {
+    for (size_t i = 0; i < ARRAY_SIZE(iface->tx_slots); i++) {
+        if (!atomic_test_and_clear_bit(iface->tx_slots_done, i)) { continue; }
 
-    int32_t ret = k_mutex_lock(&inst->mutex, K_NO_WAIT);
+        zyphal_tx_slot_t* slot = &iface->tx_slots[i];
+        zyphal_tx_t* tx = slot->tx;
+        slot->tx = NULL;
+        slot->busy = false;
+        if (tx == NULL) { continue; }
+
+        zyphal_tx_cursor_t* cursor = &tx->cursors[iface->index];
+        cursor->in_flight = 0;
+        if (slot->status != 0 || cursor->frame == tx->frames) {
+            tx_iface_done(iface, tx, slot->status);
+        }
+    }
+}
+
+static zyphal_tx_slot_t* tx_slots_get_free(zyphal_iface_t* iface) {
+    for (size_t i = 0; i < ARRAY_SIZE(iface->tx_slots); i++) {
+        if (!iface->tx_slots[i].busy) { return &iface->tx_slots[i]; }
+    }
+
+    return NULL;
+}
+
+static bool tx_slots_any_busy(zyphal_iface_t* iface) {
+    for (size_t i = 0; i < ARRAY_SIZE(iface->tx_slots); i++) {
+        if (iface->tx_slots[i].busy) { return true; }
+    }
+
+    return false;
+}
+
+static int32_t tx_send_next_frame(zyphal_iface_t* iface,
+                                  zyphal_tx_slot_t* slot,
+                                  zyphal_tx_t* tx) {
+    zyphal_tx_cursor_t* cursor = &tx->cursors[iface->index];
+    struct built_frame next;
+    if (tx->cache_hit) {
+        next = build_cached_frame(tx, cursor);
+    } else if (tx->frames == 1 && !tx->source) {
+        next = build_single_frame(tx);
+    } else {
+        next = build_next_frame(tx, cursor);
+    }
+    if (next.status < 0) { return next.status; }
+
+    /* Claim the slot first, the driver may complete the frame before can_send returns. */
+    slot->tx = tx;
+    slot->busy = true;
+    cursor->in_flight = 1;
+
+    int32_t ret =
+        can_send(iface->canbus, &next.frame, K_NO_WAIT, can_send_callback, slot);
     if (ret < 0) {
-        /* Wait some period before rescheduling, to reduce thread contention. */
-        k_work_schedule(&inst->tx_work, K_USEC(100));
-        return;
+        slot->tx = NULL;
+        slot->busy = false;
+        cursor->in_flight = 0;
+        atomic_clear_bit(iface->tx_slots_done, slot - iface->tx_slots);
+        return ret;
     }
 
-    /* Retrieve the next non-expired transfer with pending frames. */
-    zyphal_tx_t* tx = tx_queue_get_next(inst);
-    if (tx == NULL) {
-        /* No more pending transfers, no need to resubmit work. */
-        goto end;
+    zyphal_tx_backlog_sent(iface, tx, next.frame.dlc);
+    TX_STATS_INC(iface->inst, frames);
+    TX_STATS_ADD(iface->inst, bytes, can_dlc_to_bytes(next.frame.dlc));
+    ZYPHAL_TRACE(tx_frame, iface, tx, &next.frame);
+
+    /* Keep the frame for the next transfer if the cache has room for all of them. */
+    if (!tx->cache_hit && cursor->frame == tx->cache_frames &&
+        tx->frames <= tx->cache_size) {
+        tx->cache[tx->cache_frames++] = next.frame;
     }
 
-    struct built_frame next = build_next_frame(tx);
-    ret = can_send(inst->canbus, &next.frame, K_NO_WAIT, can_send_callback, tx);
-    if (ret == -EAGAIN) {
-        /* CAN driver is currently busy, reschedule work after a delay. */
-        k_work_schedule(&inst->tx_work, K_USEC(100));
-        goto end;
-    } else if (ret < 0) {
-        /* Fail the transfer.*/
-        tx_queue_remove(inst, tx, ret);
-        k_work_schedule(&inst->tx_work, K_NO_WAIT);
-        goto end;
+    /* Advance transfer state on this interface, and the shared crc if it was the first
+     * to build the frame. */
+    cursor->frame++;
+    cursor->payload_written += next.payload_len;
+    cursor->iov_index = next.iov_index;
+    cursor->iov_offset = next.iov_offset;
+    cursor->crc_written += next.crc_len;
+    cursor->toggle = !cursor->toggle;
+    if (next.crc_folded) {
+        tx->crc = next.crc;
+        tx->crc_frames++;
     }
 
-    /* CAN frame successfully sent to tx mailbox, the next work item will be scheduled
-     * from the callback after transmission. */
+    return 0;
+}
+
+/* Keeps every free slot of an interface filled with the next frame of its highest
+ * priority ready transfer. */
+static void tx_iface_service(zyphal_iface_t* iface) {
+    zyphal_inst_t* inst = iface->inst;
+
+    while (true) {
+        zyphal_tx_queue_drain(inst);
+        tx_slots_reap(iface);
+
+        zyphal_tx_slot_t* slot = tx_slots_get_free(iface);
+        if (slot == NULL) {
+            if (zyphal_tx_queue_peek_ready(iface) != NULL) {
+                TX_STATS_INC(inst, slots_full);
+            }
+            break;
+        }
+
+        zyphal_tx_t* tx = tx_queue_get_next(iface);
+        if (tx == NULL) { break; }
+
+        int32_t ret = tx_send_next_frame(iface, slot, tx);
+        if (ret == -EAGAIN) {
+            /* All controller mailboxes are full. A completion of one of our own frames
+             * resumes the work, but frames queued by other users of the controller give
+             * no such event, so only then fall back to retrying after a delay. */
+            TX_STATS_INC(inst, mailbox_full);
+            if (!tx_slots_any_busy(iface)) {
+                TX_STATS_INC(inst, busy_retries);
+                k_work_schedule_for_queue(zyphal_tx_workq(inst),
+                                          &inst->tx_work,
+                                          K_USEC(CONFIG_ZYPHAL_TX_BUSY_RETRY_US));
+            }
+            break;
+        } else if (ret < 0) {
+            /* Fail the transfer on this interface. */
+            tx_iface_done(iface, tx, ret);
+        }
+    }
+}
+
+void zyphal_tx_work_handler(struct k_work* work) {
+    struct k_work_delayable* dwork = k_work_delayable_from_work(work);
+    zyphal_inst_t* inst = CONTAINER_OF(dwork, zyphal_inst_t, tx_work);
+
+    /* Publishers only hold the mutex briefly, block rather than retry later. */
+    if (k_mutex_lock(&inst->mutex, K_NO_WAIT) < 0) {
+        k_mutex_lock(&inst->mutex, K_FOREVER);
+        TX_STATS_INC(inst, lock_waits);
+    }
 
-    /* Advance transfer state. */
-    tx->payload_written += next.payload_len;
-    tx->crc_written += next.crc_len;
-    tx->toggle = !tx->toggle;
+    /* Every interface sends at its own pace, a busy interface does not hold back the
+     * others. The work is resumed by the callback of the next completed frame on any
+     * interface, or by the next publish. */
+    for (size_t i = 0; i < inst->iface_count; i++) { tx_iface_service(&inst->ifaces[i]); }
+    tx_expiry_schedule(inst);
 
-end:
     k_mutex_unlock(&inst->mutex);
-    return;
+}
+
+/* Completes every queued transfer past its deadline, wherever it is in the priority
+ * queues, and waits for the next deadline. */
+static void tx_expiry_work_handler(struct k_work* work) {
+    struct k_work_delayable* dwork = k_work_delayable_from_work(work);
+    zyphal_inst_t* inst = CONTAINER_OF(dwork, zyphal_inst_t, tx_expiry_work);
+
+    k_mutex_lock(&inst->mutex, K_FOREVER);
+    zyphal_tx_queue_drain(inst);
+
+    zyphal_tx_t* tx;
+    while ((tx = zyphal_tx_deadline_peek(inst)) != NULL) {
+        if (!sys_timepoint_expired(tx->end)) { break; }
+        tx_complete(inst, tx, -ETIMEDOUT);
+    }
+    inst->tx_expiry_next = sys_timepoint_calc(K_FOREVER);
+    tx_expiry_schedule(inst);
+
+    k_mutex_unlock(&inst->mutex);
+}
+
+void zyphal_tx_inst_init(zyphal_inst_t* inst) {
+    zyphal_tx_queue_init(inst);
+    k_work_init_delayable(&inst->tx_work, zyphal_tx_work_handler);
+    k_work_init_delayable(&inst->tx_expiry_work, tx_expiry_work_handler);
+    inst->tx_expiry_next = sys_timepoint_calc(K_FOREVER);
+#if defined(CONFIG_ZYPHAL_TX_STATS)
+    inst->tx_stats = (zyphal_tx_stats_t){0};
+#endif
+    inst->tx_policy = ZYPHAL_TX_POLICY_ALL;
+    memset(inst->tx_sessions, 0, sizeof(inst->tx_sessions));
+    inst->tx_session_count = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(inst->ifaces); i++) {
+        zyphal_iface_t* iface = &inst->ifaces[i];
+        iface->inst = inst;
+        iface->index = i;
+        for (size_t j = 0; j < ARRAY_SIZE(iface->tx_slots); j++) {
+            iface->tx_slots[j] = (zyphal_tx_slot_t){.iface = iface};
+            atomic_clear_bit(iface->tx_slots_done, j);
+        }
+#if defined(CONFIG_ZYPHAL_TX_ADMISSION)
+        iface->tx_bit_ns = 0;
+        iface->tx_data_bit_ns = 0;
+        memset(iface->tx_backlog_us, 0, sizeof(iface->tx_backlog_us));
+#endif
+    }
+}
+
+void zyphal_tx_workq_start(zyphal_inst_t* inst) {
+#if defined(CONFIG_ZYPHAL_TX_WORKQ)
+    const struct k_work_queue_config cfg = {.name = "zyphal_tx"};
+    k_work_queue_init(&inst->tx_workq);
+    k_work_queue_start(&inst->tx_workq,
+                       inst->tx_workq_stack,
+                       K_KERNEL_STACK_SIZEOF(inst->tx_workq_stack),
+                       CONFIG_ZYPHAL_TX_WORKQ_PRIORITY,
+                       &cfg);
+#else
+    ARG_UNUSED(inst);
+#endif
 }
 
 int32_t zyphal_tx_init(zyphal_inst_t* inst, zyphal_tx_t* tx) {
@@ -227,6 +525,7 @@ int32_t zyphal_tx_init(zyphal_inst_t* inst, zyphal_tx_t* tx) {
     memset(tx, 0, sizeof(zyphal_tx_t));
 
     tx->inst = inst;
+    for (size_t i = 0; i < ARRAY_SIZE(tx->cursors); i++) { tx->cursors[i].tx = tx; }
     tx->end = sys_timepoint_calc(K_NO_WAIT);
     /* Initialized to max value so the first publish call produces transfer_id 0. */
     tx->transfer_id = TAIL_TRANSFER_ID_MASK;
@@ -234,6 +533,238 @@ int32_t zyphal_tx_init(zyphal_inst_t* inst, zyphal_tx_t* tx) {
     return 0;
 }
 
+int32_t zyphal_tx_cache_set(zyphal_tx_t* tx, struct can_frame* frames, size_t count) {
+    if (!tx || (!frames && count > 0)) { return -EINVAL; }
+    if (zyphal_tx_pending(tx)) { return -EBUSY; }
+
+    tx->cache = frames;
+    tx->cache_size = frames ? count : 0;
+    tx->cache_frames = 0;
+
+    return 0;
+}
+
+/* Returns true if the payload equals the one in the cached frames, which must hold a
+ * transfer of the same length. */
+static bool tx_cache_matches(zyphal_tx_t* tx, const zyphal_iov_t* iov, size_t iov_count) {
+    const size_t frame_payload = ZYPHAL_FRAME_MTU - TAIL_BYTE_SIZE;
+    size_t frame = 0;
+    size_t offset = 0;
+
+    for (size_t i = 0; i < iov_count; i++) {
+        const uint8_t* data = iov[i].data;
+        size_t remaining = iov[i].len;
+        while (remaining > 0) {
+            size_t len = MIN(remaining, frame_payload - offset);
+            if (memcmp(&tx->cache[frame].data[offset], data, len) != 0) { return false; }
+
+            data += len;
+            remaining -= len;
+            offset += len;
+            if (offset == frame_payload) {
+                frame++;
+                offset = 0;
+            }
+        }
+    }
+
+    return true;
+}
+
+#define TX_SESSION_TABLE_MASK (CONFIG_ZYPHAL_TX_SESSION_TABLE_SIZE - 1)
+/* Session of a transfer, every CAN ID field but priority and source node. The reserved
+ * message bits keep keys of messages nonzero, the service bit those of services. */
+#define TX_SESSION_KEY_MASK (~(CANID_PRIO_MASK | CANID_SOURCE_ID_MASK) & CAN_EXT_ID_MASK)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_ZYPHAL_TX_SESSION_TABLE_SIZE));
+
+static size_t tx_session_hash(uint32_t key) {
+    return ((key * 2654435761U) >> 16) & TX_SESSION_TABLE_MASK;
+}
+
+/* Sessions are never removed, so one slot always stays empty to end lookups. */
+int16_t zyphal_tx_session_next(zyphal_inst_t* inst, uint32_t id, bool advance) {
+    uint32_t key = id & TX_SESSION_KEY_MASK;
+    int16_t transfer_id = -1;
+    k_spinlock_key_t lock_key = k_spin_lock(&inst->tx_session_lock);
+
+    size_t i = tx_session_hash(key);
+    while (inst->tx_sessions[i].key != 0 && inst->tx_sessions[i].key != key) {
+        i = (i + 1) & TX_SESSION_TABLE_MASK;
+    }
+
+    zyphal_tx_session_t* session = &inst->tx_sessions[i];
+    if (session->key == 0 &&
+        inst->tx_session_count < CONFIG_ZYPHAL_TX_SESSION_TABLE_SIZE - 1) {
+        *session = (zyphal_tx_session_t){.key = key, .next_transfer_id = 0};
+        inst->tx_session_count++;
+    }
+    if (session->key == key) {
+        transfer_id = session->next_transfer_id;
+        if (advance) {
+            session->next_transfer_id = (transfer_id + 1) & TAIL_TRANSFER_ID_MASK;
+        }
+    }
+
+    k_spin_unlock(&inst->tx_session_lock, lock_key);
+    return transfer_id;
+}
+
+/* Resets the progress of a claimed transmitter and hands it to the transmit work. */
+static void tx_begin(zyphal_tx_t* tx,
+                     int16_t transfer_id,
+                     k_timeout_t timeout,
+                     zyphal_tx_done_cb_t cb,
+                     void* user_data) {
+    zyphal_inst_t* inst = tx->inst;
+
+    tx->end = sys_timepoint_calc(timeout);
+    /* Every interface starts from the first frame, toggle always one for first frame of
+     * transfer. */
+    for (size_t i = 0; i < inst->iface_count; i++) {
+        zyphal_tx_cursor_t* cursor = &tx->cursors[i];
+        cursor->done = 0;
+        cursor->frame = 0;
+        cursor->iov_index = 0;
+        cursor->iov_offset = 0;
+        cursor->payload_written = 0;
+        cursor->crc_written = 0;
+        cursor->toggle = 1;
+    }
+    /* Continue the transfer IDs of the session before pushing to queue, unless given
+     * explicitly, or those of the transmitter if the session table is full. */
+    if (transfer_id < 0) { transfer_id = zyphal_tx_session_next(inst, tx->id, true); }
+    tx->transfer_id = transfer_id < 0 ? (tx->transfer_id + 1) & TAIL_TRANSFER_ID_MASK
+                                      : (uint8_t)transfer_id;
+    tx->crc = UINT16_MAX;
+    tx->crc_frames = 0;
+    tx->status = 0;
+    tx->done_cb = cb;
+    tx->done_user_data = user_data;
+#if defined(CONFIG_ZYPHAL_TX_STATS)
+    tx->start_ticks = k_uptime_ticks();
+#endif
+    ZYPHAL_TRACE(tx_publish, tx);
+
+    /* Hand over to the transmit work without locking, so this may be called from an
+     * ISR. The work item moves the transfer into the priority queue of every
+     * interface once kicked. */
+    zyphal_tx_queue_handoff(inst, tx);
+}
+
+static void tx_kick(zyphal_inst_t* inst) {
+    k_work_reschedule_for_queue(zyphal_tx_workq(inst), &inst->tx_work, K_NO_WAIT);
+}
+
+static size_t tx_frame_count(size_t len) {
+    return len < ZYPHAL_FRAME_MTU ? 1
+                                  : DIV_ROUND_UP(len + MULTI_FRAME_CRC_SIZE,
+                                                 ZYPHAL_FRAME_MTU - TAIL_BYTE_SIZE);
+}
+
+/* Admits a transfer and claims the transmitter for it. */
+static int32_t tx_claim(zyphal_tx_t* tx,
+                        uint32_t id,
+                        size_t len,
+                        size_t frames,
+                        k_timeout_t timeout) {
+    /* Shed low priority transfers bound to expire in the queue before they take any. */
+    if (!zyphal_tx_admit(tx->inst, id, len, frames, timeout)) { return -EBUSY; }
+    if (!atomic_cas(&tx->pending, 0, tx->inst->iface_count)) { return -EALREADY; }
+
+    return 0;
+}
+
+/* Claims the transmitter and begins the transfer, without kicking the transmit work. */
+static int32_t tx_start(zyphal_tx_t* tx,
+                        uint32_t id,
+                        int16_t transfer_id,
+                        const zyphal_iov_t* iov,
+                        size_t iov_count,
+                        k_timeout_t timeout,
+                        zyphal_tx_done_cb_t cb,
+                        void* user_data) {
+    if (!iov && iov_count > 0) { return -EINVAL; }
+    size_t len = 0;
+    for (size_t i = 0; i < iov_count; i++) {
+        if (!iov[i].data && iov[i].len > 0) { return -EINVAL; }
+        len += iov[i].len;
+    }
+    size_t frames = tx_frame_count(len);
+    int32_t ret = tx_claim(tx, id, len, frames, timeout);
+    if (ret < 0) { return ret; }
+
+    /* The cache only holds complete transfers, so an unchanged payload can replay it. A
+     * miss starts caching this transfer instead. */
+    tx->cache_hit = tx->cache_frames > 0 && tx->cache_frames == frames &&
+                    tx->cache_id == id && tx->payload_len == len &&
+                    tx_cache_matches(tx, iov, iov_count);
+    if (!tx->cache_hit) {
+        tx->cache_id = id;
+        tx->cache_frames = 0;
+    }
+
+    tx->id = id;
+    /* A single fragment is kept in the transmitter, so callers need not keep it. */
+    if (iov_count == 1) {
+        tx->payload_iov = iov[0];
+        iov = &tx->payload_iov;
+    }
+    tx->iov = iov;
+    tx->source = NULL;
+    tx->payload_len = len;
+    tx->frames = frames;
+    tx_begin(tx, transfer_id, timeout, cb, user_data);
+
+    return 0;
+}
+
+int32_t zyphal_tx_start(zyphal_tx_t* tx,
+                        uint32_t id,
+                        int16_t transfer_id,
+                        const zyphal_iov_t* iov,
+                        size_t iov_count,
+                        k_timeout_t timeout,
+                        zyphal_tx_done_cb_t cb,
+                        void* user_data) {
+    int32_t ret = tx_start(tx, id, transfer_id, iov, iov_count, timeout, cb, user_data);
+    if (ret == 0) { tx_kick(tx->inst); }
+
+    return ret;
+}
+
+int32_t zyphal_tx_start_source(zyphal_tx_t* tx,
+                               uint32_t id,
+                               int16_t transfer_id,
+                               size_t len,
+                               zyphal_tx_source_cb_t source,
+                               void* source_user_data,
+                               k_timeout_t timeout,
+                               zyphal_tx_done_cb_t cb,
+                               void* user_data) {
+    if (!source) { return -EINVAL; }
+    size_t frames = tx_frame_count(len);
+    int32_t ret = tx_claim(tx, id, len, frames, timeout);
+    if (ret < 0) { return ret; }
+
+    /* Matching the payload would mean fetching all of it, so this transfer is cached
+     * instead of replaying the cache. */
+    tx->cache_hit = false;
+    tx->cache_id = id;
+    tx->cache_frames = 0;
+
+    tx->id = id;
+    tx->iov = NULL;
+    tx->source = source;
+    tx->source_user_data = source_user_data;
+    tx->payload_len = len;
+    tx->frames = frames;
+    tx_begin(tx, transfer_id, timeout, cb, user_data);
+    tx_kick(tx->inst);
+
+    return 0;
+}
+
 int32_t zyphal_publish(zyphal_tx_t* tx,
                        zyphal_prio_t priority,
                        uint16_t subject_id,
@@ -242,47 +773,144 @@ int32_t zyphal_publish(zyphal_tx_t* tx,
                        k_timeout_t timeout,
                        zyphal_tx_done_cb_t cb,
                        void* user_data) {
-    if (!tx || priority > ZYPHAL_PRIO_OPTIONAL || subject_id > ZYPHAL_MAX_SUBJECT_ID ||
-        (!payload && len > 0)) {
+    if (!payload && len > 0) { return -EINVAL; }
+
+    zyphal_iov_t iov = {.data = payload, .len = len};
+    return zyphal_publish_v(tx, priority, subject_id, &iov, 1, timeout, cb, user_data);
+}
+
+int32_t zyphal_publish_v(zyphal_tx_t* tx,
+                         zyphal_prio_t priority,
+                         uint16_t subject_id,
+                         const zyphal_iov_t* iov,
+                         size_t iov_count,
+                         k_timeout_t timeout,
+                         zyphal_tx_done_cb_t cb,
+                         void* user_data) {
+    if (!tx || priority > ZYPHAL_PRIO_OPTIONAL || subject_id > ZYPHAL_MAX_SUBJECT_ID) {
         return -EINVAL;
     }
-    atomic_val_t num_frames =
-        len < ZYPHAL_FRAME_MTU
-            ? 1
-            : (atomic_val_t)DIV_ROUND_UP(len + MULTI_FRAME_CRC_SIZE,
-                                         ZYPHAL_FRAME_MTU - TAIL_BYTE_SIZE);
-    if (!atomic_cas(&tx->pending, 0, num_frames)) { return -EALREADY; }
 
-    k_timepoint_t end = sys_timepoint_calc(timeout);
-    zyphal_inst_t* inst = tx->inst;
+    uint32_t id = make_canid(priority, false, false, 0, subject_id, 0, tx->inst->node_id);
+    return zyphal_tx_start(tx, id, -1, iov, iov_count, timeout, cb, user_data);
+}
 
-    tx->id = make_canid(priority, false, false, 0, subject_id, 0, inst->node_id);
-    tx->end = end;
-    tx->payload = payload;
-    tx->payload_len = len;
-    tx->payload_written = 0;
-    /* Toggle always one for first frame of transfer. */
-    tx->toggle = 1;
-    /* Increment transfer ID before pushing to queue. */
-    tx->transfer_id = (tx->transfer_id + 1) & TAIL_TRANSFER_ID_MASK;
-    tx->crc_written = 0;
-    tx->crc = UINT16_MAX;
-    tx->done_cb = cb;
-    tx->done_user_data = user_data;
+int32_t zyphal_publish_source(zyphal_tx_t* tx,
+                              zyphal_prio_t priority,
+                              uint16_t subject_id,
+                              size_t len,
+                              zyphal_tx_source_cb_t source,
+                              void* source_user_data,
+                              k_timeout_t timeout,
+                              zyphal_tx_done_cb_t cb,
+                              void* user_data) {
+    if (!tx || priority > ZYPHAL_PRIO_OPTIONAL || subject_id > ZYPHAL_MAX_SUBJECT_ID) {
+        return -EINVAL;
+    }
 
-    int32_t ret = k_mutex_lock(&inst->mutex, timeout);
-    if (ret < 0) { goto err; }
-    tx_queue_push(inst, tx);
-    k_mutex_unlock(&inst->mutex);
+    uint32_t id = make_canid(priority, false, false, 0, subject_id, 0, tx->inst->node_id);
+    return zyphal_tx_start_source(
+        tx, id, -1, len, source, source_user_data, timeout, cb, user_data);
+}
 
-    ret = k_work_schedule(&inst->tx_work, K_NO_WAIT);
-    if (ret < 0) { goto err; }
+/* Drops the reference of one transfer, or of the publishing call, completing the batch
+ * with the last one. */
+static void publish_batch_release(zyphal_publish_batch_t* batch) {
+    if (atomic_dec(&batch->remaining) == 1 && batch->cb) {
+        batch->cb(batch->user_data, (int32_t)atomic_get(&batch->status));
+    }
+}
 
-    return 0;
+static void publish_batch_done_cb(void* user_data, int32_t status) {
+    zyphal_publish_batch_t* batch = (zyphal_publish_batch_t*)user_data;
 
-err:
-    atomic_clear(&tx->pending);
-    return ret;
+    if (status < 0) { atomic_cas(&batch->status, 0, status); }
+    publish_batch_release(batch);
+}
+
+static bool publish_entry_valid(zyphal_inst_t* inst, const zyphal_publish_entry_t* e) {
+    return e->tx && e->tx->inst == inst && e->priority <= ZYPHAL_PRIO_OPTIONAL &&
+           e->subject_id <= ZYPHAL_MAX_SUBJECT_ID && (e->payload || e->len == 0);
+}
+
+int32_t zyphal_publish_batch(zyphal_inst_t* inst,
+                             zyphal_publish_entry_t* entries,
+                             size_t count,
+                             zyphal_publish_batch_t* batch,
+                             zyphal_tx_done_cb_t cb,
+                             void* user_data) {
+    if (!inst || (!entries && count > 0) || (cb && !batch)) { return -EINVAL; }
+
+    bool valid = true;
+    for (size_t i = 0; i < count; i++) {
+        entries[i].status = publish_entry_valid(inst, &entries[i]) ? -ECANCELED : -EINVAL;
+        valid = valid && entries[i].status != -EINVAL;
+    }
+    if (!valid) { return -EINVAL; }
+
+    /* The batch holds a reference of its own while publishing, so transfers completing
+     * meanwhile cannot complete it early. */
+    if (batch) {
+        if (!atomic_cas(&batch->remaining, 0, 1)) { return -EALREADY; }
+        atomic_clear(&batch->status);
+        batch->cb = cb;
+        batch->user_data = user_data;
+    }
+
+    int32_t published = 0;
+    for (size_t i = 0; i < count; i++) {
+        zyphal_publish_entry_t* entry = &entries[i];
+        uint32_t id = make_canid(
+            entry->priority, false, false, 0, entry->subject_id, 0, inst->node_id);
+        zyphal_iov_t iov = {.data = entry->payload, .len = entry->len};
+
+        if (batch) { atomic_inc(&batch->remaining); }
+        entry->status = tx_start(entry->tx,
+                                 id,
+                                 -1,
+                                 &iov,
+                                 1,
+                                 entry->timeout,
+                                 batch ? publish_batch_done_cb : NULL,
+                                 batch);
+        if (entry->status == 0) {
+            published++;
+        } else if (batch) {
+            atomic_dec(&batch->remaining);
+        }
+    }
+
+    /* Every transfer is handed off already, one kick moves them all into the queues. */
+    if (published > 0) { tx_kick(inst); }
+    if (batch) {
+        if (published > 0) {
+            publish_batch_release(batch);
+        } else {
+            atomic_clear(&batch->remaining);
+        }
+    }
+
+    return published;
+}
+
+int32_t zyphal_republish(zyphal_tx_t* tx,
+                         k_timeout_t timeout,
+                         zyphal_tx_done_cb_t cb,
+                         void* user_data) {
+    if (!tx) { return -EINVAL; }
+    if (!atomic_cas(&tx->pending, 0, tx->inst->iface_count)) { return -EALREADY; }
+
+    if (tx->cache_frames == 0 || tx->cache_frames != tx->frames) {
+        atomic_clear(&tx->pending);
+        return -ENOENT;
+    }
+
+    /* Payload fragments of the previous transfer may be gone, only the cache is used. */
+    tx->cache_hit = true;
+    tx_begin(tx, -1, timeout, cb, user_data);
+    tx_kick(tx->inst);
+
+    return 0;
 }
 
 struct publish_done_data {
@@ -320,17 +948,49 @@ bool zyphal_tx_pending(zyphal_tx_t* tx) {
 }
 
 int32_t zyphal_tx_cancel(zyphal_tx_t* tx) {
+    return zyphal_tx_cancel_timeout(tx, K_NO_WAIT);
+}
+
+int32_t zyphal_tx_cancel_timeout(zyphal_tx_t* tx, k_timeout_t timeout) {
     zyphal_inst_t* inst = tx->inst;
 
-    int32_t ret = k_mutex_lock(&inst->mutex, K_NO_WAIT);
+    int32_t ret = k_mutex_lock(&inst->mutex, timeout);
     if (ret < 0) { return -EWOULDBLOCK; }
 
+    /* The transfer may not have been moved into the priority queue yet. */
+    zyphal_tx_queue_drain(inst);
     if (!zyphal_tx_pending(tx)) {
         ret = -EALREADY;
     } else {
-        tx_queue_remove(inst, tx, -ECANCELED);
+        tx_complete(inst, tx, -ECANCELED);
     }
 
     k_mutex_unlock(&inst->mutex);
     return ret;
 }
+
+int32_t zyphal_tx_policy_set(zyphal_inst_t* inst, zyphal_tx_policy_t policy) {
+    if (!inst || (policy != ZYPHAL_TX_POLICY_ALL && policy != ZYPHAL_TX_POLICY_FIRST)) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&inst->mutex, K_FOREVER);
+    inst->tx_policy = policy;
+    k_mutex_unlock(&inst->mutex);
+
+    return 0;
+}
+
+int32_t zyphal_tx_stats_get(zyphal_inst_t* inst, zyphal_tx_stats_t* stats) {
+    if (!inst || !stats) { return -EINVAL; }
+
+#if defined(CONFIG_ZYPHAL_TX_STATS)
+    k_mutex_lock(&inst->mutex, K_FOREVER);
+    *stats = inst->tx_stats;
+    k_mutex_unlock(&inst->mutex);
+
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
@@ -3,6 +3,45 @@
 
 #include <zephyr/kernel.h>
 
+#include "zyphal/core.h"
+
+/* Initializes the transmit state of an instance. */
+void zyphal_tx_inst_init(zyphal_inst_t* inst);
+/* Starts the transmit work queue of an instance, once on its first initialization. */
+void zyphal_tx_workq_start(zyphal_inst_t* inst);
 void zyphal_tx_work_handler(struct k_work* work);
+/* Work queue that transmit and other deferred instance work runs on. */
+struct k_work_q* zyphal_tx_workq(zyphal_inst_t* inst);
+/* Starts a transfer with the given CAN ID. A negative transfer ID takes the next one
+ * of the instance session of the CAN ID, or continues the transmitter's own sequence if
+ * the session table is full. Otherwise the given transfer ID is used. */
+int32_t zyphal_tx_start(zyphal_tx_t* tx,
+                        uint32_t id,
+                        int16_t transfer_id,
+                        const zyphal_iov_t* iov,
+                        size_t iov_count,
+                        k_timeout_t timeout,
+                        zyphal_tx_done_cb_t cb,
+                        void* user_data);
+/* Starts a transfer with the given CAN ID and transfer ID as zyphal_tx_start, fetching
+ * the payload of len bytes from source. */
+int32_t zyphal_tx_start_source(zyphal_tx_t* tx,
+                               uint32_t id,
+                               int16_t transfer_id,
+                               size_t len,
+                               zyphal_tx_source_cb_t source,
+                               void* source_user_data,
+                               k_timeout_t timeout,
+                               zyphal_tx_done_cb_t cb,
+                               void* user_data);
+/* Returns the next transfer ID of the session of a CAN ID, advancing it if advance is
+ * set, or -1 if the session is new and the table is full. */
+int16_t zyphal_tx_session_next(zyphal_inst_t* inst, uint32_t id, bool advance);
+/* Cancels a pending transmission as zyphal_tx_cancel, waiting up to timeout for the
+ * instance mutex. */
+int32_t zyphal_tx_cancel_timeout(zyphal_tx_t* tx, k_timeout_t timeout);
+/* Builds the only frame of a single frame transfer, which needs neither a crc nor the
+ * fragment cursor of an interface. */
+void zyphal_tx_build_single(const zyphal_tx_t* tx, struct can_frame* frame);
 
 #endif /* TRANSMIT_H */
@@ -0,0 +1,152 @@
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/spinlock.h>
+
+LOG_MODULE_DECLARE(zyphal);
+
+#include "frame.h"
+#include "transmit.h"
+#include "tx_pool.h"
+#include "zyphal/core.h"
+
+BUILD_ASSERT(CONFIG_ZYPHAL_TX_POOL_SMALL_SIZE < CONFIG_ZYPHAL_TX_POOL_MEDIUM_SIZE);
+BUILD_ASSERT(CONFIG_ZYPHAL_TX_POOL_MEDIUM_SIZE < CONFIG_ZYPHAL_TX_POOL_LARGE_SIZE);
+
+static const size_t tx_pool_block_size[ZYPHAL_TX_POOL_CLASSES] = {
+    CONFIG_ZYPHAL_TX_POOL_SMALL_SIZE,
+    CONFIG_ZYPHAL_TX_POOL_MEDIUM_SIZE,
+    CONFIG_ZYPHAL_TX_POOL_LARGE_SIZE,
+};
+
+static const size_t tx_pool_block_count[ZYPHAL_TX_POOL_CLASSES] = {
+    CONFIG_ZYPHAL_TX_POOL_SMALL_COUNT,
+    CONFIG_ZYPHAL_TX_POOL_MEDIUM_COUNT,
+    CONFIG_ZYPHAL_TX_POOL_LARGE_COUNT,
+};
+
+static uint8_t* tx_pool_block(zyphal_inst_t* inst, const zyphal_tx_pooled_t* entry) {
+    if (entry->block_class == 0) {
+        return inst->tx_pool_small[entry->block];
+    } else if (entry->block_class == 1) {
+        return inst->tx_pool_medium[entry->block];
+    }
+    return inst->tx_pool_large[entry->block];
+}
+
+/* Takes a transmitter and the smallest free block holding len bytes, a full class
+ * spilling over into the larger ones. Returns NULL if either is exhausted. */
+static zyphal_tx_pooled_t* tx_pool_alloc(zyphal_inst_t* inst, size_t len) {
+    zyphal_tx_pool_stats_t* stats = &inst->tx_pool_stats;
+    zyphal_tx_pooled_t* entry = NULL;
+    k_spinlock_key_t key = k_spin_lock(&inst->tx_pool_lock);
+
+    size_t cls = 0;
+    while (cls < ZYPHAL_TX_POOL_CLASSES &&
+           (len > tx_pool_block_size[cls] || inst->tx_pool_blocks_free[cls] == 0)) {
+        cls++;
+    }
+
+    if (cls == ZYPHAL_TX_POOL_CLASSES || inst->tx_pool_free == 0) {
+        stats->exhausted++;
+    } else {
+        size_t i = find_lsb_set(inst->tx_pool_free) - 1;
+        size_t block = find_lsb_set(inst->tx_pool_blocks_free[cls]) - 1;
+        inst->tx_pool_free &= ~BIT(i);
+        inst->tx_pool_blocks_free[cls] &= ~BIT(block);
+
+        entry = &inst->tx_pool[i];
+        entry->block_class = cls;
+        entry->block = block;
+
+        stats->transfers_used++;
+        stats->transfers_max = MAX(stats->transfers_max, stats->transfers_used);
+        stats->blocks_used[cls]++;
+        stats->blocks_max[cls] = MAX(stats->blocks_max[cls], stats->blocks_used[cls]);
+    }
+
+    k_spin_unlock(&inst->tx_pool_lock, key);
+    return entry;
+}
+
+static void tx_pool_release(zyphal_inst_t* inst, zyphal_tx_pooled_t* entry) {
+    zyphal_tx_pool_stats_t* stats = &inst->tx_pool_stats;
+    k_spinlock_key_t key = k_spin_lock(&inst->tx_pool_lock);
+
+    inst->tx_pool_free |= BIT(entry - inst->tx_pool);
+    inst->tx_pool_blocks_free[entry->block_class] |= BIT(entry->block);
+    stats->transfers_used--;
+    stats->blocks_used[entry->block_class]--;
+
+    k_spin_unlock(&inst->tx_pool_lock, key);
+}
+
+static void tx_pool_done_cb(void* user_data, int32_t status) {
+    zyphal_tx_pooled_t* entry = (zyphal_tx_pooled_t*)user_data;
+    zyphal_tx_done_cb_t cb = entry->cb;
+    void* cb_user_data = entry->user_data;
+
+    /* Released first, so the callback may already publish into the freed entry. The
+     * transmitter is no longer touched once its done callback runs. */
+    tx_pool_release(entry->tx.inst, entry);
+    if (cb) { cb(cb_user_data, status); }
+}
+
+void zyphal_tx_pool_init(zyphal_inst_t* inst) {
+    for (size_t i = 0; i < ARRAY_SIZE(inst->tx_pool); i++) {
+        zyphal_tx_init(inst, &inst->tx_pool[i].tx);
+    }
+    inst->tx_pool_free = GENMASK(ARRAY_SIZE(inst->tx_pool) - 1, 0);
+    for (size_t i = 0; i < ZYPHAL_TX_POOL_CLASSES; i++) {
+        inst->tx_pool_blocks_free[i] = GENMASK(tx_pool_block_count[i] - 1, 0);
+    }
+    inst->tx_pool_stats = (zyphal_tx_pool_stats_t){0};
+}
+
+int32_t zyphal_publish_copy(zyphal_inst_t* inst,
+                            zyphal_prio_t priority,
+                            uint16_t subject_id,
+                            const uint8_t* payload,
+                            size_t len,
+                            k_timeout_t timeout,
+                            zyphal_tx_done_cb_t cb,
+                            void* user_data) {
+    if (!inst || (!payload && len > 0) ||
+        priority > ZYPHAL_PRIO_OPTIONAL || subject_id > ZYPHAL_MAX_SUBJECT_ID) {
+        return -EINVAL;
+    } else if (len > CONFIG_ZYPHAL_TX_POOL_LARGE_SIZE) {
+        return -EMSGSIZE;
+    }
+
+    zyphal_tx_pooled_t* entry = tx_pool_alloc(inst, len);
+    if (!entry) { return -ENOMEM; }
+
+    uint8_t* block = tx_pool_block(inst, entry);
+    if (len > 0) { memcpy(block, payload, len); }
+    entry->cb = cb;
+    entry->user_data = user_data;
+
+    zyphal_iov_t iov = {.data = block, .len = len};
+    uint32_t id = make_canid(priority, false, false, 0, subject_id, 0, inst->node_id);
+    int32_t ret = zyphal_tx_start(&entry->tx,
+                                  id,
+                                  -1,
+                                  &iov,
+                                  1,
+                                  timeout,
+                                  tx_pool_done_cb,
+                                  entry);
+    if (ret < 0) { tx_pool_release(inst, entry); }
+    return ret;
+}
+
+int32_t zyphal_tx_pool_stats_get(zyphal_inst_t* inst, zyphal_tx_pool_stats_t* stats) {
+    if (!inst || !stats) { return -EINVAL; }
+
+    k_spinlock_key_t key = k_spin_lock(&inst->tx_pool_lock);
+    *stats = inst->tx_pool_stats;
+    k_spin_unlock(&inst->tx_pool_lock, key);
+
+    return 0;
+}
@@ -0,0 +1,10 @@
+#ifndef TX_POOL_H
+#define TX_POOL_H
+
+#include "zyphal/core.h"
+
+/* Initializes the transmitters and payload blocks of the transfer pool of an instance,
+ * all of them free. */
+void zyphal_tx_pool_init(zyphal_inst_t* inst);
+
+#endif /* TX_POOL_H */
@@ -0,0 +1,143 @@
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mpsc_lockfree.h>
+#include <zephyr/sys/rb.h>
+
+#include "admission.h"
+#include "frame.h"
+#include "trace.h"
+#include "tx_queue.h"
+#include "zyphal/core.h"
+
+/* Priority is the most significant part of the CAN ID, so a tree per priority level
+ * keeps full CAN ID ordering. The level bitmap finds the highest priority non-empty
+ * tree without visiting the others. */
+static zyphal_tx_t* tx_queue_node_tx(struct rbnode* node) {
+    return CONTAINER_OF(node, zyphal_tx_cursor_t, node)->tx;
+}
+
+static bool tx_queue_lessthan(struct rbnode* a, struct rbnode* b) {
+    zyphal_tx_t* tx_a = tx_queue_node_tx(a);
+    zyphal_tx_t* tx_b = tx_queue_node_tx(b);
+
+    if (tx_a->id != tx_b->id) { return tx_a->id < tx_b->id; }
+    /* Equal CAN IDs are sent in the order they were pushed. */
+    return (int32_t)(tx_a->seq - tx_b->seq) < 0;
+}
+
+static bool tx_deadline_lessthan(struct rbnode* a, struct rbnode* b) {
+    zyphal_tx_t* tx_a = CONTAINER_OF(a, zyphal_tx_t, deadline_node);
+    zyphal_tx_t* tx_b = CONTAINER_OF(b, zyphal_tx_t, deadline_node);
+
+    int cmp = sys_timepoint_cmp(tx_a->end, tx_b->end);
+    if (cmp != 0) { return cmp < 0; }
+    /* The tree needs a strict order, equal deadlines expire in push order. */
+    return (int32_t)(tx_a->seq - tx_b->seq) < 0;
+}
+
+static uint8_t tx_queue_level(zyphal_tx_t* tx) {
+    return (tx->id & CANID_PRIO_MASK) >> CANID_PRIO_SHIFT;
+}
+
+void zyphal_tx_queue_init(zyphal_inst_t* inst) {
+    for (size_t i = 0; i < ARRAY_SIZE(inst->ifaces); i++) {
+        zyphal_iface_t* iface = &inst->ifaces[i];
+        for (size_t level = 0; level < ARRAY_SIZE(iface->tx_queue); level++) {
+            iface->tx_queue[level] = (struct rbtree){.lessthan_fn = tx_queue_lessthan};
+        }
+        iface->tx_queue_levels = 0;
+    }
+    inst->tx_deadlines = (struct rbtree){.lessthan_fn = tx_deadline_lessthan};
+    inst->tx_queue_seq = 0;
+    mpsc_init(&inst->tx_handoff);
+}
+
+void zyphal_tx_queue_handoff(zyphal_inst_t* inst, zyphal_tx_t* tx) {
+    mpsc_push(&inst->tx_handoff, &tx->handoff_node);
+}
+
+void zyphal_tx_queue_drain(zyphal_inst_t* inst) {
+    /* A producer interrupted mid push makes the queue look empty until it finishes, it
+     * reschedules the transmit work afterwards so the transfer is not missed. */
+    struct mpsc_node* node;
+    while ((node = mpsc_pop(&inst->tx_handoff)) != NULL) {
+        zyphal_tx_t* tx = CONTAINER_OF(node, zyphal_tx_t, handoff_node);
+
+        /* One push order for all interfaces, each then sends at its own pace. */
+        tx->seq = inst->tx_queue_seq++;
+        zyphal_tx_deadline_push(inst, tx);
+        for (size_t i = 0; i < inst->iface_count; i++) {
+            zyphal_tx_queue_push(&inst->ifaces[i], tx);
+            zyphal_tx_backlog_add(&inst->ifaces[i], tx);
+            ZYPHAL_TRACE(tx_enqueue, &inst->ifaces[i], tx);
+        }
+
+#if defined(CONFIG_ZYPHAL_TX_STATS)
+        inst->tx_stats.published++;
+        inst->tx_stats.depth++;
+        inst->tx_stats.depth_max = MAX(inst->tx_stats.depth_max, inst->tx_stats.depth);
+#endif
+    }
+}
+
+void zyphal_tx_queue_push(zyphal_iface_t* iface, zyphal_tx_t* tx) {
+    zyphal_tx_cursor_t* cursor = &tx->cursors[iface->index];
+    uint8_t level = tx_queue_level(tx);
+
+    cursor->queued = 1;
+    rb_insert(&iface->tx_queue[level], &cursor->node);
+    iface->tx_queue_levels |= BIT(level);
+}
+
+void zyphal_tx_queue_remove(zyphal_iface_t* iface, zyphal_tx_t* tx) {
+    zyphal_tx_cursor_t* cursor = &tx->cursors[iface->index];
+    if (!cursor->queued) { return; }
+    uint8_t level = tx_queue_level(tx);
+
+    rb_remove(&iface->tx_queue[level], &cursor->node);
+    cursor->queued = 0;
+    if (iface->tx_queue[level].root == NULL) { iface->tx_queue_levels &= ~BIT(level); }
+}
+
+zyphal_tx_t* zyphal_tx_queue_peek_ready(zyphal_iface_t* iface) {
+    uint8_t levels = iface->tx_queue_levels;
+    while (levels != 0) {
+        uint8_t level = find_lsb_set(levels) - 1;
+        levels &= ~BIT(level);
+
+        /* Equal CAN IDs are adjacent, so a receiver never sees two transfers of the same
+         * session interleaved. */
+        bool blocked = false;
+        uint32_t blocked_id = 0;
+        zyphal_tx_cursor_t* cursor;
+        RB_FOR_EACH_CONTAINER(&iface->tx_queue[level], cursor, node) {
+            if (cursor->in_flight) {
+                blocked = true;
+                blocked_id = cursor->tx->id;
+            } else if (!blocked || cursor->tx->id != blocked_id) {
+                return cursor->tx;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void zyphal_tx_deadline_push(zyphal_inst_t* inst, zyphal_tx_t* tx) {
+    if (K_TIMEOUT_EQ(sys_timepoint_timeout(tx->end), K_FOREVER)) { return; }
+
+    rb_insert(&inst->tx_deadlines, &tx->deadline_node);
+    tx->deadline_queued = true;
+}
+
+void zyphal_tx_deadline_remove(zyphal_inst_t* inst, zyphal_tx_t* tx) {
+    if (!tx->deadline_queued) { return; }
+
+    rb_remove(&inst->tx_deadlines, &tx->deadline_node);
+    tx->deadline_queued = false;
+}
+
+zyphal_tx_t* zyphal_tx_deadline_peek(zyphal_inst_t* inst) {
+    struct rbnode* node = rb_get_min(&inst->tx_deadlines);
+    return node != NULL ? CONTAINER_OF(node, zyphal_tx_t, deadline_node) : NULL;
+}
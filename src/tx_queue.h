@@ -0,0 +1,26 @@
+#ifndef TX_QUEUE_H
+#define TX_QUEUE_H
+
+#include "zyphal/core.h"
+
+/* Priority queue of pending transfers per interface, ordered by CAN ID and then by push
+ * order. Callers must hold the instance mutex, except for handoff. */
+void zyphal_tx_queue_init(zyphal_inst_t* inst);
+/* Hands a transfer to the queue without locking, safe to call from any context. */
+void zyphal_tx_queue_handoff(zyphal_inst_t* inst, zyphal_tx_t* tx);
+/* Pushes all handed off transfers onto every interface, in the order they were handed
+ * off. */
+void zyphal_tx_queue_drain(zyphal_inst_t* inst);
+void zyphal_tx_queue_push(zyphal_iface_t* iface, zyphal_tx_t* tx);
+void zyphal_tx_queue_remove(zyphal_iface_t* iface, zyphal_tx_t* tx);
+/* Returns the highest priority queued transfer that may send its next frame, skipping
+ * transfers with a frame in flight and those queued behind one with the same CAN ID. */
+zyphal_tx_t* zyphal_tx_queue_peek_ready(zyphal_iface_t* iface);
+/* Index of queued transfers ordered by deadline, shared by all interfaces. Transfers
+ * without a deadline are not indexed. */
+void zyphal_tx_deadline_push(zyphal_inst_t* inst, zyphal_tx_t* tx);
+void zyphal_tx_deadline_remove(zyphal_inst_t* inst, zyphal_tx_t* tx);
+/* Returns the queued transfer with the earliest deadline, or NULL if there is none. */
+zyphal_tx_t* zyphal_tx_deadline_peek(zyphal_inst_t* inst);
+
+#endif /* TX_QUEUE_H */
@@ -0,0 +1,33 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+#if defined(CONFIG_ARCH_POSIX)
+#include <time.h>
+#endif
+
+/* native_sim does not advance its simulated clock while code runs, so host time is
+ * used there instead of the cycle counter. */
+typedef uint64_t bench_time_t;
+
+static inline bench_time_t bench_now(void) {
+#if defined(CONFIG_ARCH_POSIX)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#else
+    return k_cycle_get_32();
+#endif
+}
+
+static inline uint64_t bench_elapsed_ns(bench_time_t start) {
+#if defined(CONFIG_ARCH_POSIX)
+    return bench_now() - start;
+#else
+    return k_cyc_to_ns_floor64((uint32_t)(bench_now() - start));
+#endif
+}
+
+#endif /* BENCH_H */
@@ -0,0 +1,60 @@
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/ztest.h>
+
+#include "bench.h"
+#include "crc.h"
+#include "zyphal/core.h"
+
+/* Compare table sizes with -DCONFIG_ZYPHAL_CRC_TABLE_SLICES=<n>. */
+
+#define MAX_LEN (4096)
+#define TOTAL_BYTES (1024 * 1024)
+
+static uint8_t data[MAX_LEN];
+/* Keeps results live, so the calculations are not optimized away. */
+static volatile uint16_t sink;
+
+typedef uint16_t (*crc_fn_t)(uint16_t crc, const uint8_t* data, size_t len);
+
+/* Transfers are hashed one CAN FD frame of payload at a time. */
+static uint64_t bench_crc_fn(crc_fn_t fn, size_t len) {
+    size_t transfers = TOTAL_BYTES / len;
+    uint16_t crc = 0;
+
+    bench_time_t start = bench_now();
+    for (size_t t = 0; t < transfers; t++) {
+        crc = UINT16_MAX;
+        for (size_t pos = 0; pos < len; pos += 63) {
+            crc = fn(crc, &data[pos], MIN(63, len - pos));
+        }
+    }
+    uint64_t elapsed = bench_elapsed_ns(start);
+
+    sink = crc;
+    return elapsed * 1024 / (transfers * len);
+}
+
+ZTEST(crc_bench, ns_per_kib) {
+    const size_t lens[] = {64, 256, 1024, MAX_LEN};
+    for (size_t i = 0; i < sizeof(data); i++) { data[i] = (uint8_t)(i * 31 + 7); }
+
+    const char* backend = IS_ENABLED(CONFIG_ZYPHAL_CRC_TABLE)    ? "table"
+                          : IS_ENABLED(CONFIG_ZYPHAL_CRC_CUSTOM) ? "custom"
+                                                                 : "zephyr";
+    TC_PRINT("crc backend: %s, slices: %d\n",
+             backend,
+             COND_CODE_1(CONFIG_ZYPHAL_CRC_TABLE, (CONFIG_ZYPHAL_CRC_TABLE_SLICES), (0)));
+    TC_PRINT("transfer bytes, zyphal_crc16 ns per KiB, crc16_itu_t ns per KiB\n");
+    for (size_t i = 0; i < ARRAY_SIZE(lens); i++) {
+        uint64_t zyphal = bench_crc_fn(zyphal_crc16, lens[i]);
+        uint64_t zephyr = bench_crc_fn(crc16_itu_t, lens[i]);
+        TC_PRINT("%zu, %llu, %llu\n",
+                 lens[i],
+                 (unsigned long long)zyphal,
+                 (unsigned long long)zephyr);
+    }
+}
+
+ZTEST_SUITE(crc_bench, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,108 @@
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/ztest.h>
+
+#include "bench.h"
+#include "can_vbus.h"
+#include "zyphal/core.h"
+
+/* Every node publishes as fast as its transfers complete, with priorities spread over
+ * the nodes, while subscribing to the subject of the next node. Latencies per priority
+ * show whether higher priority traffic keeps its share of the saturated bus. */
+
+#define TRANSFERS_PER_NODE (32)
+#define PAYLOAD_LEN (48)
+#define LEVELS (ZYPHAL_PRIO_OPTIONAL + 1)
+
+static zyphal_inst_t insts[CAN_VBUS_NODES];
+static zyphal_tx_t txs[CAN_VBUS_NODES];
+static zyphal_sub_t subs[CAN_VBUS_NODES];
+static uint8_t payload[PAYLOAD_LEN];
+static int64_t publish_ticks[CAN_VBUS_NODES];
+static size_t published[CAN_VBUS_NODES];
+static uint64_t latency_us[LEVELS];
+static uint32_t latency_count[LEVELS];
+static atomic_t remaining;
+static K_SEM_DEFINE(finished_sem, 0, 1);
+
+static void bench_done_cb(void* user_data, int32_t status);
+
+static void publish_node(size_t i) {
+    published[i]++;
+    publish_ticks[i] = k_uptime_ticks();
+    zassert_ok(zyphal_publish(&txs[i],
+                              i % LEVELS,
+                              i,
+                              payload,
+                              sizeof(payload),
+                              K_FOREVER,
+                              bench_done_cb,
+                              (void*)(uintptr_t)i));
+}
+
+static void bench_done_cb(void* user_data, int32_t status) {
+    size_t i = (size_t)(uintptr_t)user_data;
+    zassert_ok(status);
+
+    latency_us[i % LEVELS] += k_ticks_to_us_floor64(k_uptime_ticks() - publish_ticks[i]);
+    latency_count[i % LEVELS]++;
+    if (published[i] < TRANSFERS_PER_NODE) {
+        publish_node(i);
+    } else if (atomic_dec(&remaining) == 1) {
+        k_sem_give(&finished_sem);
+    }
+}
+
+static void bench_rx_cb(const zyphal_rx_transfer_t* transfer, void* user_data) {}
+
+static void bench_network(size_t nodes) {
+    can_vbus_reset();
+    can_vbus_set_bitrate(1000000, COND_CODE_1(CONFIG_ZYPHAL_CAN_FD, (5000000), (0)));
+    memset(published, 0, sizeof(published));
+    memset(latency_us, 0, sizeof(latency_us));
+    memset(latency_count, 0, sizeof(latency_count));
+    atomic_set(&remaining, nodes);
+
+    for (size_t i = 0; i < nodes; i++) {
+        zassert_ok(zyphal_init(&insts[i], can_vbus_node(i), i + 1));
+        zassert_ok(zyphal_tx_init(&insts[i], &txs[i]));
+        zassert_ok(zyphal_subscribe(
+            &insts[i], &subs[i], (i + 1) % nodes, PAYLOAD_LEN, bench_rx_cb, NULL));
+    }
+
+    bench_time_t start = bench_now();
+    int64_t start_ticks = k_uptime_ticks();
+    k_sched_lock();
+    for (size_t i = 0; i < nodes; i++) { publish_node(i); }
+    k_sched_unlock();
+    zassert_ok(k_sem_take(&finished_sem, K_FOREVER));
+    uint64_t cpu_ns = bench_elapsed_ns(start);
+    uint64_t kernel_us = k_ticks_to_us_floor64(k_uptime_ticks() - start_ticks);
+
+    struct can_vbus_stats stats;
+    can_vbus_stats_get(&stats);
+    TC_PRINT("network, %s, %zu, %llu, %llu, %llu",
+             IS_ENABLED(CONFIG_ZYPHAL_CAN_FD) ? "fd" : "classic",
+             nodes,
+             (unsigned long long)(cpu_ns / stats.frames),
+             (unsigned long long)(stats.frames * USEC_PER_SEC / MAX(kernel_us, 1)),
+             (unsigned long long)(stats.busy_us * 100 / MAX(kernel_us, 1)));
+    for (size_t l = 0; l < LEVELS; l++) {
+        uint64_t mean_us = latency_us[l] / MAX(latency_count[l], 1);
+        TC_PRINT(", %llu", (unsigned long long)mean_us);
+    }
+    TC_PRINT("\n");
+}
+
+ZTEST(network_bench, nodes_scaling) {
+    const size_t nodes[] = {8, 32, CAN_VBUS_NODES};
+    for (size_t i = 0; i < sizeof(payload); i++) { payload[i] = (uint8_t)i; }
+
+    TC_PRINT("suite, can, nodes, cpu ns per frame, frames per s, bus load pct, "
+             "prio 0 us, prio 1 us, prio 2 us, prio 3 us, prio 4 us, prio 5 us, "
+             "prio 6 us, prio 7 us\n");
+    for (size_t i = 0; i < ARRAY_SIZE(nodes); i++) { bench_network(nodes[i]); }
+}
+
+ZTEST_SUITE(network_bench, NULL, NULL, NULL, NULL, NULL);
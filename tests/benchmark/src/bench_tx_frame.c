@@ -0,0 +1,147 @@
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "bench.h"
+#include "crc.h"
+#include "frame.h"
+#include "transmit.h"
+#include "zyphal/core.h"
+
+#define ITERATIONS (100000)
+
+static uint8_t payload[ZYPHAL_FRAME_MTU];
+/* Frames are written here, so the compiler cannot drop the work. */
+static volatile uint8_t sink;
+
+/* Single frame building through the general multi-frame builder, as used before the
+ * single frame path, kept as a reference point for the results. */
+struct legacy_frame {
+    struct can_frame frame;
+    size_t payload_len;
+    uint8_t crc_len;
+    uint16_t crc;
+    bool crc_folded;
+    size_t iov_index;
+    size_t iov_offset;
+};
+
+static struct legacy_frame legacy_build(const zyphal_tx_t* tx) {
+    bool single = tx->frames == 1;
+    struct legacy_frame out;
+    memset(&out, 0, sizeof(out));
+    out.crc = tx->crc;
+    out.crc_folded = !single;
+
+    out.payload_len = MIN(tx->payload_len, (ZYPHAL_FRAME_MTU - TAIL_BYTE_SIZE));
+    size_t copied = 0;
+    while (copied < out.payload_len) {
+        const zyphal_iov_t* iov = &tx->iov[out.iov_index];
+        size_t len = MIN(iov->len - out.iov_offset, out.payload_len - copied);
+        if (len > 0) { memcpy(&out.frame.data[copied], &iov->data[out.iov_offset], len); }
+        copied += len;
+        out.iov_offset += len;
+        if (out.iov_offset == iov->len) {
+            out.iov_index++;
+            out.iov_offset = 0;
+        }
+    }
+    if (out.crc_folded) { out.crc = zyphal_crc16(out.crc, out.frame.data, copied); }
+
+    size_t crc_remaining = single ? 0 : MULTI_FRAME_CRC_SIZE;
+    size_t crc_space = (ZYPHAL_FRAME_MTU - TAIL_BYTE_SIZE) - out.payload_len;
+    out.crc_len = MIN(crc_remaining, crc_space);
+
+    size_t frame_dlc = can_bytes_to_dlc(out.payload_len + out.crc_len + TAIL_BYTE_SIZE);
+    size_t padding_len =
+        can_dlc_to_bytes(frame_dlc) - (out.payload_len + out.crc_len + TAIL_BYTE_SIZE);
+    if (padding_len > 0) { memset(&out.frame.data[out.payload_len], 0, padding_len); }
+
+    out.frame.data[out.payload_len + padding_len + out.crc_len] =
+        TAIL_START_BIT | TAIL_END_BIT | TAIL_TOGGLE_BIT | tx->transfer_id;
+    out.frame.id = tx->id;
+    out.frame.flags =
+        CAN_FRAME_IDE |
+        COND_CODE_1(CONFIG_ZYPHAL_CAN_FD, (CAN_FRAME_FDF | CAN_FRAME_BRS), (0));
+    out.frame.dlc =
+        can_bytes_to_dlc(out.payload_len + padding_len + out.crc_len + TAIL_BYTE_SIZE);
+
+    return out;
+}
+
+static void bench_setup(zyphal_tx_t* tx, zyphal_iov_t* iov, size_t len) {
+    memset(tx, 0, sizeof(*tx));
+    *iov = (zyphal_iov_t){.data = payload, .len = len};
+    tx->id = make_canid(ZYPHAL_PRIO_NOMINAL, false, false, 0, 1234, 0, 42);
+    tx->iov = iov;
+    tx->payload_len = len;
+    tx->frames = 1;
+    tx->crc = UINT16_MAX;
+}
+
+static uint64_t bench_single(size_t len) {
+    zyphal_tx_t tx;
+    zyphal_iov_t iov;
+    struct can_frame frame;
+    bench_setup(&tx, &iov, len);
+
+    bench_time_t start = bench_now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        tx.transfer_id = i & TAIL_TRANSFER_ID_MASK;
+        zyphal_tx_build_single(&tx, &frame);
+        sink = frame.data[can_dlc_to_bytes(frame.dlc) - TAIL_BYTE_SIZE];
+    }
+    return bench_elapsed_ns(start) * 1000 / ITERATIONS;
+}
+
+static uint64_t bench_legacy(size_t len) {
+    zyphal_tx_t tx;
+    zyphal_iov_t iov;
+    bench_setup(&tx, &iov, len);
+
+    bench_time_t start = bench_now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        tx.transfer_id = i & TAIL_TRANSFER_ID_MASK;
+        struct legacy_frame out = legacy_build(&tx);
+        sink = out.frame.data[can_dlc_to_bytes(out.frame.dlc) - TAIL_BYTE_SIZE];
+    }
+    return bench_elapsed_ns(start) * 1000 / ITERATIONS;
+}
+
+/* Both builders must produce the same frame, or the comparison is meaningless. */
+static void check_equal(size_t len) {
+    zyphal_tx_t tx;
+    zyphal_iov_t iov;
+    struct can_frame frame;
+    bench_setup(&tx, &iov, len);
+
+    zyphal_tx_build_single(&tx, &frame);
+    struct legacy_frame out = legacy_build(&tx);
+    zassert_equal(frame.id, out.frame.id);
+    zassert_equal(frame.dlc, out.frame.dlc);
+    zassert_equal(frame.flags, out.frame.flags);
+    zassert_mem_equal(frame.data, out.frame.data, can_dlc_to_bytes(frame.dlc));
+}
+
+ZTEST(tx_frame_bench, single_frame_build) {
+    const size_t lens[] = {0, 3, 7, 11, 31, 47, 63};
+    for (size_t i = 0; i < sizeof(payload); i++) { payload[i] = (uint8_t)i; }
+
+    TC_PRINT("suite, can, payload bytes, single ps per frame, general ps per frame\n");
+    for (size_t i = 0; i < ARRAY_SIZE(lens); i++) {
+        if (lens[i] >= ZYPHAL_FRAME_MTU) { continue; }
+
+        check_equal(lens[i]);
+        uint64_t single = bench_single(lens[i]);
+        uint64_t legacy = bench_legacy(lens[i]);
+        TC_PRINT("tx_frame, %s, %zu, %llu, %llu\n",
+                 IS_ENABLED(CONFIG_ZYPHAL_CAN_FD) ? "fd" : "classic",
+                 lens[i],
+                 (unsigned long long)single,
+                 (unsigned long long)legacy);
+    }
+}
+
+ZTEST_SUITE(tx_frame_bench, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,105 @@
+#include <stdint.h>
+#include <zephyr/drivers/can/can_fake.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "zyphal/core.h"
+
+/* Build with -DEXTRA_CONF_FILE=workq.conf to compare against the dedicated transmit
+ * work queue. */
+
+DEFINE_FFF_GLOBALS;
+
+#define NODE_ID (0x55)
+#define SUBJECT_ID (0x1234)
+#define SAMPLES (64)
+/* A work item of another subsystem, blocking the system work queue while it sleeps. */
+#define SLOW_WORK_US (2000)
+
+static const struct device* canbus = DEVICE_DT_GET(DT_NODELABEL(fake_can));
+static zyphal_inst_t inst;
+
+static K_SEM_DEFINE(dispatch_sem, 0, 1);
+static uint32_t dispatch_cycles;
+
+static int32_t dispatch_send(const struct device* dev,
+                             const struct can_frame* frame,
+                             k_timeout_t timeout,
+                             can_tx_callback_t callback,
+                             void* user_data) {
+    dispatch_cycles = k_cycle_get_32();
+    if (callback) { callback(dev, 0, user_data); }
+    k_sem_give(&dispatch_sem);
+    return 0;
+}
+
+static void slow_work_handler(struct k_work* work) {
+    k_usleep(SLOW_WORK_US);
+}
+static K_WORK_DEFINE(slow_work, slow_work_handler);
+
+struct latency {
+    uint64_t min;
+    uint64_t max;
+    uint64_t mean;
+};
+
+/* Kernel time from publish until the frame reaches the driver. This is dominated by
+ * sleeping work items rather than CPU time, so the cycle counter is used on every
+ * platform. */
+static struct latency bench_dispatch(bool busy) {
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+
+    struct latency out = {.min = UINT64_MAX};
+    uint64_t total = 0;
+    uint8_t pl[] = {1};
+    for (size_t i = 0; i < SAMPLES; i++) {
+        if (busy) {
+            /* Publish at varying points into the slow work item. */
+            k_work_submit(&slow_work);
+            k_usleep(1 + (i % 8) * (SLOW_WORK_US / 8));
+        }
+
+        uint32_t start = k_cycle_get_32();
+        zassert_ok(zyphal_publish(
+            &tx, ZYPHAL_PRIO_EXCEPTIONAL, SUBJECT_ID, pl, 1, K_MSEC(100), NULL, NULL));
+        zassert_ok(k_sem_take(&dispatch_sem, K_MSEC(100)));
+        uint64_t ns = k_cyc_to_ns_floor64(dispatch_cycles - start);
+
+        out.min = MIN(out.min, ns);
+        out.max = MAX(out.max, ns);
+        total += ns;
+
+        /* Let the slow work item finish before the next sample. */
+        k_usleep(SLOW_WORK_US);
+    }
+    out.mean = total / SAMPLES;
+
+    return out;
+}
+
+static void tx_latency_bench_before(void* f) {
+    zassert_true(device_is_ready(canbus));
+    zassert_ok(zyphal_init(&inst, canbus, NODE_ID));
+    fake_can_send_fake.custom_fake = dispatch_send;
+}
+
+ZTEST(tx_latency_bench, dispatch_jitter) {
+    const char* queue = IS_ENABLED(CONFIG_ZYPHAL_TX_WORKQ) ? "dedicated" : "system";
+
+    TC_PRINT("tx work queue, system work queue, min ns, mean ns, max ns, jitter ns\n");
+    for (size_t i = 0; i < 2; i++) {
+        bool busy = i == 1;
+        struct latency lat = bench_dispatch(busy);
+        TC_PRINT("%s, %s, %llu, %llu, %llu, %llu\n",
+                 queue,
+                 busy ? "busy" : "idle",
+                 (unsigned long long)lat.min,
+                 (unsigned long long)lat.mean,
+                 (unsigned long long)lat.max,
+                 (unsigned long long)(lat.max - lat.min));
+    }
+}
+
+ZTEST_SUITE(tx_latency_bench, NULL, NULL, tx_latency_bench_before, NULL, NULL);
@@ -0,0 +1,107 @@
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/ztest.h>
+
+#include "bench.h"
+#include "tx_queue.h"
+#include "zyphal/core.h"
+
+#define MAX_DEPTH (1024)
+#define ITERATIONS (20000)
+
+static zyphal_inst_t inst;
+static zyphal_tx_t txs[MAX_DEPTH];
+
+/* Sorted singly linked list insertion, as used before the bucketed queue, kept as a
+ * reference point for the results. */
+struct legacy_item {
+    sys_snode_t node;
+    uint32_t id;
+};
+static sys_slist_t legacy_queue;
+static struct legacy_item legacy_items[MAX_DEPTH];
+
+static void legacy_push(struct legacy_item* item) {
+    struct legacy_item* prev = NULL;
+    struct legacy_item* cur;
+
+    SYS_SLIST_FOR_EACH_CONTAINER(&legacy_queue, cur, node) {
+        if (item->id < cur->id) { break; }
+        prev = cur;
+    }
+
+    if (prev == NULL) {
+        sys_slist_prepend(&legacy_queue, &item->node);
+    } else {
+        sys_slist_insert(&legacy_queue, &prev->node, &item->node);
+    }
+}
+
+/* Random priority and subject, as seen with many independent publishers. */
+static uint32_t random_id(uint32_t* seed) {
+    *seed = *seed * 1103515245 + 12345;
+    uint32_t prio = (*seed >> 16) & 0x7;
+    *seed = *seed * 1103515245 + 12345;
+    uint32_t subject = (*seed >> 16) & 0x1FFF;
+    return (prio << 26) | (3 << 21) | (subject << 8) | 0x55;
+}
+
+/* Steady state cost of popping the highest priority transfer and pushing a new one,
+ * with the queue held at a constant depth. Nothing is in flight, so the next ready
+ * transfer is the highest priority one. */
+static uint64_t bench_queue(size_t depth) {
+    uint32_t seed = 1;
+    zyphal_iface_t* iface = &inst.ifaces[0];
+    zyphal_tx_queue_init(&inst);
+    for (size_t i = 0; i < depth; i++) {
+        txs[i].cursors[0].tx = &txs[i];
+        txs[i].id = random_id(&seed);
+        txs[i].seq = inst.tx_queue_seq++;
+        zyphal_tx_queue_push(iface, &txs[i]);
+    }
+
+    bench_time_t start = bench_now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        zyphal_tx_t* tx = zyphal_tx_queue_peek_ready(iface);
+        zyphal_tx_queue_remove(iface, tx);
+        tx->id = random_id(&seed);
+        tx->seq = inst.tx_queue_seq++;
+        zyphal_tx_queue_push(iface, tx);
+    }
+    return bench_elapsed_ns(start) / ITERATIONS;
+}
+
+static uint64_t bench_legacy(size_t depth) {
+    uint32_t seed = 1;
+    sys_slist_init(&legacy_queue);
+    for (size_t i = 0; i < depth; i++) {
+        legacy_items[i].id = random_id(&seed);
+        legacy_push(&legacy_items[i]);
+    }
+
+    bench_time_t start = bench_now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        sys_snode_t* node = sys_slist_get_not_empty(&legacy_queue);
+        struct legacy_item* item = CONTAINER_OF(node, struct legacy_item, node);
+        item->id = random_id(&seed);
+        legacy_push(item);
+    }
+    return bench_elapsed_ns(start) / ITERATIONS;
+}
+
+ZTEST(tx_queue_bench, push_pop_vs_depth) {
+    const size_t depths[] = {1, 8, 32, 128, 256, 512, 1024};
+
+    TC_PRINT("depth, bucketed ns per push+pop, sorted list ns per push+pop\n");
+    for (size_t i = 0; i < ARRAY_SIZE(depths); i++) {
+        uint64_t bucketed = bench_queue(depths[i]);
+        uint64_t legacy = bench_legacy(depths[i]);
+        TC_PRINT("%zu, %llu, %llu\n",
+                 depths[i],
+                 (unsigned long long)bucketed,
+                 (unsigned long long)legacy);
+    }
+}
+
+ZTEST_SUITE(tx_queue_bench, NULL, NULL, NULL, NULL, NULL);
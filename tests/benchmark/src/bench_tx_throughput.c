@@ -0,0 +1,207 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <zephyr/drivers/can/can_fake.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "bench.h"
+#include "zyphal/core.h"
+
+/* Build with -DEXTRA_CONF_FILE=classic.conf to compare against classic CAN. Rows start
+ * with the suite name, scripts/bench_compare.py compares them between two runs. */
+
+#define NODE_ID (0x55)
+#define SUBJECT_ID (0x1000)
+#define TRANSFERS (256)
+#define MAX_PAYLOAD (4096)
+#define MAX_TRANSMITTERS (16)
+/* Frames the modelled controller holds at once, further sends are refused until the
+ * oldest one has been sent. */
+#define MAILBOXES (3)
+
+static const struct device* canbus = DEVICE_DT_GET(DT_NODELABEL(fake_can));
+static zyphal_inst_t inst;
+
+/* Controller sending one frame at a time, each taking the completion latency. Zero
+ * completes frames within the send call, leaving only the CPU cost of the stack. */
+struct mailbox {
+    can_tx_callback_t callback;
+    void* user_data;
+};
+static struct mailbox mailboxes[MAILBOXES];
+static size_t mailbox_head;
+static size_t mailbox_len;
+static uint32_t completion_us;
+static size_t frames_sent;
+
+static void mailbox_timer_handler(struct k_timer* timer) {
+    struct mailbox done = mailboxes[mailbox_head];
+    mailbox_head = (mailbox_head + 1) % MAILBOXES;
+    mailbox_len--;
+    if (mailbox_len > 0) { k_timer_start(timer, K_USEC(completion_us), K_NO_WAIT); }
+
+    if (done.callback) { done.callback(canbus, 0, done.user_data); }
+}
+static K_TIMER_DEFINE(mailbox_timer, mailbox_timer_handler, NULL);
+
+static int32_t bench_send(const struct device* dev,
+                          const struct can_frame* frame,
+                          k_timeout_t timeout,
+                          can_tx_callback_t callback,
+                          void* user_data) {
+    if (completion_us == 0) {
+        frames_sent++;
+        if (callback) { callback(dev, 0, user_data); }
+        return 0;
+    }
+
+    unsigned int key = irq_lock();
+    if (mailbox_len == MAILBOXES) {
+        irq_unlock(key);
+        return -EAGAIN;
+    }
+    mailboxes[(mailbox_head + mailbox_len) % MAILBOXES] =
+        (struct mailbox){.callback = callback, .user_data = user_data};
+    bool idle = mailbox_len++ == 0;
+    irq_unlock(key);
+
+    frames_sent++;
+    if (idle) { k_timer_start(&mailbox_timer, K_USEC(completion_us), K_NO_WAIT); }
+    return 0;
+}
+
+struct throughput {
+    uint64_t publish_ns;
+    uint64_t ns_per_frame;
+    uint64_t frames_per_s;
+    uint32_t p50_us;
+    uint32_t p90_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+};
+
+static zyphal_tx_t txs[MAX_TRANSMITTERS];
+static uint8_t payload[MAX_PAYLOAD];
+static size_t payload_len;
+static int64_t publish_ticks[MAX_TRANSMITTERS];
+static uint32_t latency_us[TRANSFERS];
+static size_t started;
+static size_t finished;
+static uint64_t publish_ns;
+static K_SEM_DEFINE(finished_sem, 0, 1);
+
+static void bench_done_cb(void* user_data, int32_t status);
+
+static void publish_next(size_t i) {
+    started++;
+    publish_ticks[i] = k_uptime_ticks();
+
+    bench_time_t start = bench_now();
+    int32_t ret = zyphal_publish(&txs[i],
+                                 ZYPHAL_PRIO_NOMINAL,
+                                 SUBJECT_ID + i,
+                                 payload,
+                                 payload_len,
+                                 K_FOREVER,
+                                 bench_done_cb,
+                                 (void*)(uintptr_t)i);
+    publish_ns += bench_elapsed_ns(start);
+    zassert_ok(ret);
+}
+
+/* Each transmitter publishes its next transfer as soon as the previous one completes,
+ * keeping the queue at the number of transmitters. */
+static void bench_done_cb(void* user_data, int32_t status) {
+    size_t i = (size_t)(uintptr_t)user_data;
+    zassert_ok(status);
+
+    int64_t ticks = k_uptime_ticks() - publish_ticks[i];
+    latency_us[finished++] = (uint32_t)k_ticks_to_us_floor64(ticks);
+    if (started < TRANSFERS) {
+        publish_next(i);
+    } else if (finished == TRANSFERS) {
+        k_sem_give(&finished_sem);
+    }
+}
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* CPU cost is taken from the benchmark clock, which is host time on native_sim. Frame
+ * rate and latencies are kernel time, only meaningful there with a completion latency
+ * since the simulated clock stands still while code runs. */
+static struct throughput bench_throughput(size_t len, size_t transmitters, uint32_t us) {
+    payload_len = len;
+    completion_us = us;
+    started = 0;
+    finished = 0;
+    frames_sent = 0;
+    publish_ns = 0;
+    for (size_t i = 0; i < transmitters; i++) {
+        zassert_ok(zyphal_tx_init(&inst, &txs[i]));
+    }
+
+    bench_time_t start = bench_now();
+    int64_t start_ticks = k_uptime_ticks();
+    /* The transmit work must not start completing transfers before all have started. */
+    k_sched_lock();
+    for (size_t i = 0; i < transmitters; i++) { publish_next(i); }
+    k_sched_unlock();
+    zassert_ok(k_sem_take(&finished_sem, K_FOREVER));
+    uint64_t cpu_ns = bench_elapsed_ns(start);
+    uint64_t kernel_ns = k_ticks_to_ns_floor64(k_uptime_ticks() - start_ticks);
+
+    qsort(latency_us, TRANSFERS, sizeof(latency_us[0]), compare_u32);
+    return (struct throughput){
+        .publish_ns = publish_ns / TRANSFERS,
+        .ns_per_frame = cpu_ns / frames_sent,
+        .frames_per_s = kernel_ns > 0 ? frames_sent * NSEC_PER_SEC / kernel_ns : 0,
+        .p50_us = latency_us[TRANSFERS * 50 / 100],
+        .p90_us = latency_us[TRANSFERS * 90 / 100],
+        .p99_us = latency_us[TRANSFERS * 99 / 100],
+        .max_us = latency_us[TRANSFERS - 1],
+    };
+}
+
+static void tx_throughput_bench_before(void* f) {
+    zassert_true(device_is_ready(canbus));
+    zassert_ok(zyphal_init(&inst, canbus, NODE_ID));
+    fake_can_send_fake.custom_fake = bench_send;
+}
+
+ZTEST(tx_throughput_bench, payload_transmitters_matrix) {
+    const size_t lens[] = {0, 7, 63, 256, MAX_PAYLOAD};
+    const size_t transmitters[] = {1, 4, MAX_TRANSMITTERS};
+    const uint32_t completions_us[] = {0, 100};
+    const char* can = IS_ENABLED(CONFIG_ZYPHAL_CAN_FD) ? "fd" : "classic";
+    for (size_t i = 0; i < sizeof(payload); i++) { payload[i] = (uint8_t)i; }
+
+    TC_PRINT("suite, can, payload bytes, transmitters, completion us, publish ns, "
+             "cpu ns per frame, frames per s, p50 us, p90 us, p99 us, max us\n");
+    for (size_t l = 0; l < ARRAY_SIZE(lens); l++) {
+        for (size_t t = 0; t < ARRAY_SIZE(transmitters); t++) {
+            for (size_t c = 0; c < ARRAY_SIZE(completions_us); c++) {
+                struct throughput res =
+                    bench_throughput(lens[l], transmitters[t], completions_us[c]);
+                TC_PRINT("tx_throughput, %s, %zu, %zu, %u, %llu, %llu, %llu, %u, %u, %u, "
+                         "%u\n",
+                         can,
+                         lens[l],
+                         transmitters[t],
+                         completions_us[c],
+                         (unsigned long long)res.publish_ns,
+                         (unsigned long long)res.ns_per_frame,
+                         (unsigned long long)res.frames_per_s,
+                         res.p50_us,
+                         res.p90_us,
+                         res.p99_us,
+                         res.max_us);
+            }
+        }
+    }
+}
+
+ZTEST_SUITE(tx_throughput_bench, NULL, NULL, tx_throughput_bench_before, NULL, NULL);
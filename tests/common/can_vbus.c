@@ -0,0 +1,299 @@
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+
+#include "can_vbus.h"
+
+/* Transmit mailboxes and acceptance filters of each controller. */
+#define VBUS_MAILBOXES (3)
+#define VBUS_FILTERS (16)
+
+/* Bits of an extended ID frame without stuff bits. CAN FD sends the control field, data
+ * and CRC at the data bitrate if the frame switches bitrate. */
+#define FD_NOMINAL_BITS (49)
+#define FD_DATA_BITS(bytes) (5 + 8 * (bytes) + ((bytes) > 16 ? 32 : 27))
+#define CLASSIC_BITS(bytes) (67 + 8 * (bytes))
+
+struct vbus_mailbox {
+    bool used;
+    /* Submission order, frames with equal IDs leave a controller in this order. */
+    uint32_t seq;
+    struct can_frame frame;
+    can_tx_callback_t callback;
+    void* user_data;
+};
+
+struct vbus_filter {
+    bool used;
+    struct can_filter filter;
+    can_rx_callback_t callback;
+    void* user_data;
+};
+
+struct vbus_node {
+    struct vbus_mailbox mailboxes[VBUS_MAILBOXES];
+    struct vbus_filter filters[VBUS_FILTERS];
+};
+
+static struct vbus_node vbus_nodes[CAN_VBUS_NODES];
+static struct k_spinlock vbus_lock;
+/* Mailbox of the frame on the bus and its node, NULL while the bus is idle. */
+static struct vbus_mailbox* vbus_current;
+static size_t vbus_current_node;
+static uint32_t vbus_seq;
+static uint32_t vbus_bit_ns;
+static uint32_t vbus_data_bit_ns;
+/* Error rate, and transmissions since the last error. */
+static uint32_t vbus_error_one_in;
+static uint32_t vbus_error_count;
+static can_vbus_monitor_t vbus_monitor;
+static struct can_vbus_stats vbus_stats;
+
+static void vbus_timer_handler(struct k_timer* timer);
+static K_TIMER_DEFINE(vbus_timer, vbus_timer_handler, NULL);
+
+static size_t vbus_node_index(const struct device* dev) {
+    return (struct vbus_node*)dev->data - vbus_nodes;
+}
+
+static uint32_t vbus_airtime_us(const struct can_frame* frame) {
+    size_t bytes = can_dlc_to_bytes(frame->dlc);
+    bool brs = (frame->flags & CAN_FRAME_BRS) != 0;
+    uint32_t data_bit_ns = brs ? vbus_data_bit_ns : vbus_bit_ns;
+
+    uint64_t ns = (frame->flags & CAN_FRAME_FDF)
+                      ? (uint64_t)FD_NOMINAL_BITS * vbus_bit_ns +
+                            (uint64_t)FD_DATA_BITS(bytes) * data_bit_ns
+                      : (uint64_t)CLASSIC_BITS(bytes) * vbus_bit_ns;
+    return (uint32_t)(ns / NSEC_PER_USEC);
+}
+
+/* Puts the pending frame with the lowest CAN ID on the idle bus, ties going to the lower
+ * node index and then to the older frame. Must be called with the lock held. */
+static void vbus_arbitrate(void) {
+    struct vbus_mailbox* best = NULL;
+    size_t best_node = 0;
+
+    for (size_t i = 0; i < CAN_VBUS_NODES; i++) {
+        for (size_t j = 0; j < VBUS_MAILBOXES; j++) {
+            struct vbus_mailbox* mb = &vbus_nodes[i].mailboxes[j];
+            if (!mb->used) { continue; }
+
+            bool wins = best == NULL || mb->frame.id < best->frame.id ||
+                        (mb->frame.id == best->frame.id && best_node == i &&
+                         (int32_t)(mb->seq - best->seq) < 0);
+            if (wins) {
+                best = mb;
+                best_node = i;
+            }
+        }
+    }
+    if (best == NULL) { return; }
+
+    vbus_current = best;
+    vbus_current_node = best_node;
+    k_timer_start(&vbus_timer, K_USEC(vbus_airtime_us(&best->frame)), K_NO_WAIT);
+}
+
+static bool vbus_filter_matches(const struct can_filter* filter,
+                                const struct can_frame* frame) {
+    bool ide = (frame->flags & CAN_FRAME_IDE) != 0;
+    bool filter_ide = (filter->flags & CAN_FILTER_IDE) != 0;
+    return ide == filter_ide && (frame->id & filter->mask) == (filter->id & filter->mask);
+}
+
+/* Delivers a frame to the matching filters of every node but its sender. Filters are
+ * copied under the lock, so callbacks may add or remove filters. */
+static void vbus_deliver(size_t sender, const struct can_frame* frame) {
+    for (size_t i = 0; i < CAN_VBUS_NODES; i++) {
+        if (i == sender) { continue; }
+
+        struct vbus_filter filters[VBUS_FILTERS];
+        k_spinlock_key_t key = k_spin_lock(&vbus_lock);
+        memcpy(filters, vbus_nodes[i].filters, sizeof(filters));
+        k_spin_unlock(&vbus_lock, key);
+
+        for (size_t j = 0; j < VBUS_FILTERS; j++) {
+            if (filters[j].used && vbus_filter_matches(&filters[j].filter, frame)) {
+                filters[j].callback(
+                    can_vbus_node(i), (struct can_frame*)frame, filters[j].user_data);
+            }
+        }
+    }
+}
+
+static void vbus_timer_handler(struct k_timer* timer) {
+    k_spinlock_key_t key = k_spin_lock(&vbus_lock);
+
+    struct vbus_mailbox* mb = vbus_current;
+    size_t sender = vbus_current_node;
+    vbus_current = NULL;
+    if (mb == NULL) {
+        /* Reset while the frame was on the bus. */
+        k_spin_unlock(&vbus_lock, key);
+        return;
+    }
+    vbus_stats.busy_us += vbus_airtime_us(&mb->frame);
+
+    /* A destroyed frame stays in its mailbox, and competes in the next arbitration. */
+    if (vbus_error_one_in > 0 && ++vbus_error_count >= vbus_error_one_in) {
+        vbus_error_count = 0;
+        vbus_stats.errors++;
+        vbus_arbitrate();
+        k_spin_unlock(&vbus_lock, key);
+        return;
+    }
+
+    struct vbus_mailbox sent = *mb;
+    mb->used = false;
+    vbus_stats.frames++;
+    can_vbus_monitor_t monitor = vbus_monitor;
+    k_spin_unlock(&vbus_lock, key);
+
+    /* Called without the lock, receivers and the sender may send further frames. */
+    vbus_deliver(sender, &sent.frame);
+    if (monitor) { monitor(sender, &sent.frame); }
+    if (sent.callback) { sent.callback(can_vbus_node(sender), 0, sent.user_data); }
+
+    key = k_spin_lock(&vbus_lock);
+    if (vbus_current == NULL) { vbus_arbitrate(); }
+    k_spin_unlock(&vbus_lock, key);
+}
+
+/* Never blocks, a full controller refuses the frame like a send with K_NO_WAIT. */
+static int vbus_send(const struct device* dev,
+                     const struct can_frame* frame,
+                     k_timeout_t timeout,
+                     can_tx_callback_t callback,
+                     void* user_data) {
+    struct vbus_node* node = &vbus_nodes[vbus_node_index(dev)];
+    k_spinlock_key_t key = k_spin_lock(&vbus_lock);
+
+    for (size_t i = 0; i < VBUS_MAILBOXES; i++) {
+        struct vbus_mailbox* mb = &node->mailboxes[i];
+        if (mb->used) { continue; }
+
+        *mb = (struct vbus_mailbox){.used = true,
+                                    .seq = vbus_seq++,
+                                    .frame = *frame,
+                                    .callback = callback,
+                                    .user_data = user_data};
+        if (vbus_current == NULL) { vbus_arbitrate(); }
+        k_spin_unlock(&vbus_lock, key);
+        return 0;
+    }
+
+    k_spin_unlock(&vbus_lock, key);
+    return -EAGAIN;
+}
+
+static int vbus_add_rx_filter(const struct device* dev,
+                              can_rx_callback_t callback,
+                              void* user_data,
+                              const struct can_filter* filter) {
+    struct vbus_node* node = &vbus_nodes[vbus_node_index(dev)];
+    k_spinlock_key_t key = k_spin_lock(&vbus_lock);
+
+    int ret = -ENOSPC;
+    for (size_t i = 0; i < VBUS_FILTERS; i++) {
+        if (!node->filters[i].used) {
+            node->filters[i] = (struct vbus_filter){.used = true,
+                                                    .filter = *filter,
+                                                    .callback = callback,
+                                                    .user_data = user_data};
+            ret = i;
+            break;
+        }
+    }
+
+    k_spin_unlock(&vbus_lock, key);
+    return ret;
+}
+
+static void vbus_remove_rx_filter(const struct device* dev, int filter_id) {
+    struct vbus_node* node = &vbus_nodes[vbus_node_index(dev)];
+    if (filter_id < 0 || filter_id >= VBUS_FILTERS) { return; }
+
+    k_spinlock_key_t key = k_spin_lock(&vbus_lock);
+    node->filters[filter_id].used = false;
+    k_spin_unlock(&vbus_lock, key);
+}
+
+static int vbus_get_max_filters(const struct device* dev, bool ide) {
+    return VBUS_FILTERS;
+}
+
+static int vbus_init(const struct device* dev) {
+    return 0;
+}
+
+static const struct can_driver_api vbus_api = {
+    .send = vbus_send,
+    .add_rx_filter = vbus_add_rx_filter,
+    .remove_rx_filter = vbus_remove_rx_filter,
+    .get_max_filters = vbus_get_max_filters,
+};
+
+#define VBUS_NODE_DEFINE(i, _)                        \
+    DEVICE_DEFINE(can_vbus_##i,                       \
+                  "can_vbus_" #i,                     \
+                  vbus_init,                          \
+                  NULL,                               \
+                  &vbus_nodes[i],                     \
+                  NULL,                               \
+                  POST_KERNEL,                        \
+                  CONFIG_KERNEL_INIT_PRIORITY_DEVICE, \
+                  &vbus_api);
+LISTIFY(CAN_VBUS_NODES, VBUS_NODE_DEFINE, ())
+
+#define VBUS_NODE_DEVICE(i, _) DEVICE_GET(can_vbus_##i)
+static const struct device* const vbus_devices[] = {
+    LISTIFY(CAN_VBUS_NODES, VBUS_NODE_DEVICE, (, ))};
+
+const struct device* can_vbus_node(size_t index) {
+    return index < CAN_VBUS_NODES ? vbus_devices[index] : NULL;
+}
+
+void can_vbus_reset(void) {
+    k_timer_stop(&vbus_timer);
+
+    k_spinlock_key_t key = k_spin_lock(&vbus_lock);
+    memset(vbus_nodes, 0, sizeof(vbus_nodes));
+    vbus_current = NULL;
+    vbus_bit_ns = 0;
+    vbus_data_bit_ns = 0;
+    vbus_error_one_in = 0;
+    vbus_error_count = 0;
+    vbus_monitor = NULL;
+    vbus_stats = (struct can_vbus_stats){0};
+    k_spin_unlock(&vbus_lock, key);
+}
+
+void can_vbus_set_bitrate(uint32_t bitrate, uint32_t bitrate_data) {
+    k_spinlock_key_t key = k_spin_lock(&vbus_lock);
+    vbus_bit_ns = bitrate > 0 ? NSEC_PER_SEC / bitrate : 0;
+    vbus_data_bit_ns = bitrate_data > 0 ? NSEC_PER_SEC / bitrate_data : vbus_bit_ns;
+    k_spin_unlock(&vbus_lock, key);
+}
+
+void can_vbus_set_error_rate(uint32_t one_in) {
+    k_spinlock_key_t key = k_spin_lock(&vbus_lock);
+    vbus_error_one_in = one_in;
+    vbus_error_count = 0;
+    k_spin_unlock(&vbus_lock, key);
+}
+
+void can_vbus_set_monitor(can_vbus_monitor_t monitor) {
+    k_spinlock_key_t key = k_spin_lock(&vbus_lock);
+    vbus_monitor = monitor;
+    k_spin_unlock(&vbus_lock, key);
+}
+
+void can_vbus_stats_get(struct can_vbus_stats* stats) {
+    k_spinlock_key_t key = k_spin_lock(&vbus_lock);
+    *stats = vbus_stats;
+    k_spin_unlock(&vbus_lock, key);
+}
@@ -0,0 +1,38 @@
+#ifndef CAN_VBUS_H
+#define CAN_VBUS_H
+
+#include <stdint.h>
+#include <zephyr/drivers/can.h>
+
+/* Virtual CAN bus connecting CAN_VBUS_NODES controllers within one process. Frames go on
+ * the bus one at a time, the pending frame with the lowest CAN ID across all controllers
+ * winning arbitration, and occupy it for the airtime of their bits. Every other
+ * controller receives them through its matching filters, from the timer ISR. */
+#ifndef CAN_VBUS_NODES
+#define CAN_VBUS_NODES (8)
+#endif
+
+struct can_vbus_stats {
+    /* Frames sent successfully, and transmissions destroyed by an error frame. */
+    uint32_t frames;
+    uint32_t errors;
+    /* Time in microseconds the bus was occupied by frames. */
+    uint64_t busy_us;
+};
+
+/* Called for every frame successfully sent on the bus, with the index of its sender. */
+typedef void (*can_vbus_monitor_t)(size_t node, const struct can_frame* frame);
+
+/* Returns the controller device of a node. */
+const struct device* can_vbus_node(size_t index);
+/* Drops all pending frames, filters, settings and statistics, leaving the bus idle. */
+void can_vbus_reset(void);
+/* Sets the nominal and data phase bitrates, frames take no time at a bitrate of zero. */
+void can_vbus_set_bitrate(uint32_t bitrate, uint32_t bitrate_data);
+/* Destroys one in every n transmissions with an error frame, after which the sender
+ * retransmits it. Zero disables errors. */
+void can_vbus_set_error_rate(uint32_t one_in);
+void can_vbus_set_monitor(can_vbus_monitor_t monitor);
+void can_vbus_stats_get(struct can_vbus_stats* stats);
+
+#endif /* CAN_VBUS_H */
@@ -27,21 +27,72 @@ static struct can_frame can_fff_frame_history_get_next(void) {
     return frame;
 }
 
+#define CAN_FFF_MAX_FILTERS (32)
+
+struct can_fff_filter {
+    bool used;
+    struct can_filter filter;
+    can_rx_callback_t callback;
+    void* user_data;
+};
+static struct can_fff_filter can_fff_filters[CAN_FFF_MAX_FILTERS];
+
+static int32_t can_fff_add_rx_filter_custom(const struct device* dev,
+                                            can_rx_callback_t callback,
+                                            void* user_data,
+                                            const struct can_filter* filter) {
+    for (int32_t i = 0; i < CAN_FFF_MAX_FILTERS; i++) {
+        if (!can_fff_filters[i].used) {
+            can_fff_filters[i] = (struct can_fff_filter){.used = true,
+                                                         .filter = *filter,
+                                                         .callback = callback,
+                                                         .user_data = user_data};
+            return i;
+        }
+    }
+    return -ENOSPC;
+}
+
+static void can_fff_remove_rx_filter_custom(const struct device* dev, int filter_id) {
+    if (filter_id >= 0 && filter_id < CAN_FFF_MAX_FILTERS) {
+        can_fff_filters[filter_id].used = false;
+    }
+}
+
+#define CAN_FFF_MAX_DEFERRED (32)
+
+struct can_fff_deferred {
+    can_tx_callback_t callback;
+    void* user_data;
+};
+static struct can_fff_deferred can_fff_deferred[CAN_FFF_MAX_DEFERRED];
+static size_t can_fff_deferred_len;
+static bool can_fff_defer_completion;
+
 static volatile int32_t can_fff_send_custom_return_val = 0;
 static int32_t can_fff_send_custom(const struct device* dev,
                                    const struct can_frame* frame,
                                    k_timeout_t timeout,
                                    can_tx_callback_t callback,
                                    void* user_data) {
+    /* Like a real driver, rejected frames are never completed. */
+    if (can_fff_send_custom_return_val != 0) { return can_fff_send_custom_return_val; }
+
     /* Add the received frame to the history. */
-    if (can_fff_send_custom_return_val == 0) {
-        can_fff_frame_history_append(frame);
+    can_fff_frame_history_append(frame);
+
+    /* Deferred frames stay in flight until explicitly completed. */
+    if (can_fff_defer_completion) {
+        zassert_true(can_fff_deferred_len < CAN_FFF_MAX_DEFERRED, "Too many frames.");
+        can_fff_deferred[can_fff_deferred_len++] =
+            (struct can_fff_deferred){.callback = callback, .user_data = user_data};
+        return 0;
     }
 
     /* Running the callback will give a semaphore, preventing deadlock. */
     if (callback) { callback(dev, 0, user_data); }
 
-    return can_fff_send_custom_return_val;
+    return 0;
 }
 
 void can_fff_history_reset(void) {
@@ -53,9 +104,15 @@ void can_fff_history_reset(void) {
 void can_fff_ztest_before(void) {
     /* Ensure the custom fake handler is always set. */
     fake_can_send_fake.custom_fake = can_fff_send_custom;
+    fake_can_add_rx_filter_fake.custom_fake = can_fff_add_rx_filter_custom;
+    fake_can_remove_rx_filter_fake.custom_fake = can_fff_remove_rx_filter_custom;
+    RESET_FAKE(fake_can_get_max_filters);
 
-    /* Fresh history for every new test. */
+    /* Fresh history and filters for every new test. */
     can_fff_history_reset();
+    memset(can_fff_filters, 0, sizeof(can_fff_filters));
+    can_fff_defer_completion = false;
+    can_fff_deferred_len = 0;
 }
 
 void can_fff_assert_frames_empty(void) {
@@ -90,3 +147,72 @@ void can_fff_assert_popped_frame_equal(struct can_frame frame) {
 void can_fff_set_send_status(int32_t status) {
     can_fff_send_custom_return_val = status;
 }
+
+size_t can_fff_filter_count(void) {
+    size_t count = 0;
+    for (size_t i = 0; i < CAN_FFF_MAX_FILTERS; i++) {
+        if (can_fff_filters[i].used) { count++; }
+    }
+    return count;
+}
+
+bool can_fff_filter_accepts(uint32_t id) {
+    for (size_t i = 0; i < CAN_FFF_MAX_FILTERS; i++) {
+        struct can_fff_filter* f = &can_fff_filters[i];
+        if (f->used && (f->filter.flags & CAN_FILTER_IDE) &&
+            (id & f->filter.mask) == (f->filter.id & f->filter.mask)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void can_fff_rx_frame(struct can_frame frame) {
+    for (size_t i = 0; i < CAN_FFF_MAX_FILTERS; i++) {
+        struct can_fff_filter* f = &can_fff_filters[i];
+        if (!f->used) { continue; }
+
+        bool ide = (frame.flags & CAN_FRAME_IDE) != 0;
+        bool filter_ide = (f->filter.flags & CAN_FILTER_IDE) != 0;
+        if (ide != filter_ide) { continue; }
+        if ((frame.id & f->filter.mask) != (f->filter.id & f->filter.mask)) { continue; }
+
+        f->callback(DEVICE_DT_GET(DT_NODELABEL(fake_can)), &frame, f->user_data);
+    }
+
+    /* Let the receive work dispatch the frame before returning. */
+    k_sleep(K_MSEC(1));
+}
+
+void can_fff_history_loopback(void) {
+    while (!sys_slist_is_empty(&can_fff_history)) {
+        can_fff_rx_frame(can_fff_frame_history_get_next());
+    }
+}
+
+void can_fff_set_deferred_completion(bool deferred) {
+    can_fff_defer_completion = deferred;
+}
+
+size_t can_fff_deferred_count(void) {
+    return can_fff_deferred_len;
+}
+
+void can_fff_complete_deferred(size_t count) {
+    zassert_true(count <= can_fff_deferred_len, "Not enough frames in flight.");
+
+    /* Callbacks may send further frames, so remove the completed ones first. */
+    struct can_fff_deferred completed[CAN_FFF_MAX_DEFERRED];
+    memcpy(completed, can_fff_deferred, count * sizeof(completed[0]));
+    can_fff_deferred_len -= count;
+    memmove(can_fff_deferred,
+            &can_fff_deferred[count],
+            can_fff_deferred_len * sizeof(can_fff_deferred[0]));
+
+    for (size_t i = 0; i < count; i++) {
+        if (completed[i].callback) {
+            completed[i].callback(
+                DEVICE_DT_GET(DT_NODELABEL(fake_can)), 0, completed[i].user_data);
+        }
+    }
+}
@@ -9,6 +9,20 @@ void can_fff_ztest_before(void);
 void can_fff_history_reset(void);
 /* Sets the returned status of send calls. */
 void can_fff_set_send_status(int32_t status);
+/* Returns the number of currently added receive filters. */
+size_t can_fff_filter_count(void);
+/* Returns true if an extended CAN ID passes any added receive filter. */
+bool can_fff_filter_accepts(uint32_t id);
+/* Delivers a frame to all matching receive filters, and waits for it to be handled. */
+void can_fff_rx_frame(struct can_frame frame);
+/* Delivers all frames in the history to the receive filters, emptying the history. */
+void can_fff_history_loopback(void);
+/* Holds sent frames in flight until completed, instead of completing them on send. */
+void can_fff_set_deferred_completion(bool deferred);
+/* Returns the number of sent frames that have not yet been completed. */
+size_t can_fff_deferred_count(void);
+/* Completes the oldest in flight frames, in the order they were sent. */
+void can_fff_complete_deferred(size_t count);
 
 /* ZTest assertion helpers. */
 void can_fff_assert_frames_empty(void);
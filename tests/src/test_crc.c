@@ -0,0 +1,66 @@
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/ztest.h>
+
+#include "crc.h"
+#include "zyphal/core.h"
+
+#define MAX_TRANSFER_LEN (4096)
+
+#if defined(CONFIG_ZYPHAL_CRC_CUSTOM)
+uint16_t zyphal_crc16_custom(uint16_t crc, const uint8_t* data, size_t len) {
+    return crc16_itu_t(crc, data, len);
+}
+#endif
+
+static uint8_t data[MAX_TRANSFER_LEN + 8];
+
+static void crc_suite_before(void* f) {
+    uint32_t seed = 1;
+    for (size_t i = 0; i < sizeof(data); i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+ZTEST(crc, check_value) {
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    zassert_equal(zyphal_crc16(UINT16_MAX, check, sizeof(check)), 0x29B1);
+    zassert_equal(zyphal_crc16(0x1234, check, 0), 0x1234);
+}
+
+ZTEST(crc, lengths_and_alignment) {
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t len = 0; len <= 64; len++) {
+            zassert_equal(zyphal_crc16(UINT16_MAX, &data[offset], len),
+                          crc16_itu_t(UINT16_MAX, &data[offset], len),
+                          "offset %zu, length %zu",
+                          offset,
+                          len);
+        }
+    }
+}
+
+ZTEST(crc, frame_mtus) {
+    /* Transfer CRCs are built up frame by frame, with MTU minus the tail byte of payload
+     * per frame, for every MTU a CAN or CAN FD frame can have. */
+    const size_t mtus[] = {8, 12, 16, 20, 24, 32, 48, 64};
+    const size_t transfer_lens[] = {8, 63, 64, 187, 1000, 1024, MAX_TRANSFER_LEN};
+
+    for (size_t m = 0; m < ARRAY_SIZE(mtus); m++) {
+        for (size_t t = 0; t < ARRAY_SIZE(transfer_lens); t++) {
+            uint16_t crc = UINT16_MAX;
+            uint16_t expected = UINT16_MAX;
+            for (size_t pos = 0; pos < transfer_lens[t]; pos += mtus[m] - 1) {
+                size_t len = MIN(mtus[m] - 1, transfer_lens[t] - pos);
+                crc = zyphal_crc16(crc, &data[pos], len);
+                expected = crc16_itu_t(expected, &data[pos], len);
+            }
+            zassert_equal(
+                crc, expected, "mtu %zu, transfer %zu", mtus[m], transfer_lens[t]);
+        }
+    }
+}
+
+ZTEST_SUITE(crc, NULL, NULL, crc_suite_before, NULL, NULL);
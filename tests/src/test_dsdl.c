@@ -0,0 +1,217 @@
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/drivers/can/can_fake.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <ztest/Echo_1_0.h>
+#include <ztest/Sample_1_0.h>
+#include <ztest/Status_1_0.h>
+
+#include "can_fff.h"
+#include "zyphal/core.h"
+
+#define NODE_ID (0x55)
+#define SUBJECT_ID (0x1234)
+
+/* Bounds are known at compile time. */
+BUILD_ASSERT(ztest_Status_1_0_MAX_SIZE_BYTES == 9);
+BUILD_ASSERT(ztest_Status_1_0_EXTENT_BYTES == ztest_Status_1_0_MAX_SIZE_BYTES);
+BUILD_ASSERT(ztest_Sample_1_0_EXTENT_BYTES == 512);
+BUILD_ASSERT(ztest_Echo_Request_1_0_FIXED_PORT_ID == 432);
+
+static const ztest_Status_1_0 status = {
+    .health = ztest_Status_1_0_HEALTH_WARNING,
+    .flag = true,
+    .temperature = -2,
+    .ratio = 1.0f,
+    .level = 0x1F,
+    .code = {1, 2, 3},
+};
+static const uint8_t status_bytes[] = {0x06, 0xFE, 0xFF, 0x00, 0x3C, 0x0F, 1, 2, 3};
+
+static const struct device* canbus = DEVICE_DT_GET(DT_NODELABEL(fake_can));
+static zyphal_inst_t inst;
+
+static ztest_Sample_1_0 sample;
+static ztest_Sample_1_0 sample_out;
+static uint8_t buf[ztest_Sample_1_0_EXTENT_BYTES];
+
+static void dsdl_suite_before(void* f) {
+    zassert_true(device_is_ready(canbus));
+    zassert_ok(zyphal_init(&inst, canbus, NODE_ID));
+    can_fff_ztest_before();
+
+    memset(&sample, 0, sizeof(sample));
+    sample.status = status;
+    sample.history[0] = status;
+    sample.history[1].health = 1;
+    sample.history[1].ratio = -0.5f;
+    sample.samples.count = 5;
+    for (size_t i = 0; i < sample.samples.count; i++) {
+        sample.samples.elements[i] = 0x800 + i * 300;
+    }
+    sample.meta.sequence = 0xDEADBEEF;
+    sample.meta.tags.count = 2;
+    sample.meta.tags.elements[0] = 7;
+    sample.meta.tags.elements[1] = 9;
+    sample.value._tag_ = 2;
+    sample.value.text.count = 3;
+    memcpy(sample.value.text.elements, "abc", 3);
+    sample.bits[0] = true;
+    sample.bits[2] = true;
+    sample.blob.count = ARRAY_SIZE(sample.blob.elements);
+    for (size_t i = 0; i < sample.blob.count; i++) { sample.blob.elements[i] = i * 7; }
+}
+
+ZTEST(dsdl, fixed_layout) {
+    size_t size = sizeof(buf);
+    zassert_ok(ztest_Status_1_0_serialize(&status, buf, &size));
+    zassert_equal(size, sizeof(status_bytes));
+    /* The truncated level keeps its low bits, padding is zero. */
+    zassert_mem_equal(buf, status_bytes, sizeof(status_bytes));
+
+    ztest_Status_1_0 out;
+    zassert_ok(ztest_Status_1_0_deserialize(&out, buf, &size));
+    zassert_equal(out.health, status.health);
+    zassert_true(out.flag);
+    zassert_equal(out.temperature, -2);
+    zassert_equal(out.ratio, 1.0f);
+    zassert_equal(out.level, 0xF);
+    zassert_mem_equal(out.code, status.code, sizeof(out.code));
+
+    /* Missing bytes read as zero. */
+    size = 3;
+    zassert_ok(ztest_Status_1_0_deserialize(&out, buf, &size));
+    zassert_equal(size, 3);
+    zassert_equal(out.temperature, -2);
+    zassert_equal(out.ratio, 0.0f);
+
+    size = sizeof(status_bytes) - 1;
+    zassert_equal(ztest_Status_1_0_serialize(&status, buf, &size), -EMSGSIZE);
+}
+
+ZTEST(dsdl, variable_layout) {
+    size_t size = sizeof(buf);
+    zassert_ok(ztest_Sample_1_0_serialize(&sample, buf, &size));
+    zassert_equal(ztest_Sample_1_0_serialized_size(&sample), (int32_t)size);
+    zassert_true(size <= ztest_Sample_1_0_MAX_SIZE_BYTES);
+    /* Nested fixed layout types are packed in place. */
+    zassert_mem_equal(buf, status_bytes, sizeof(status_bytes));
+
+    zassert_ok(ztest_Sample_1_0_deserialize(&sample_out, buf, &size));
+    zassert_equal(sample_out.samples.count, 5);
+    zassert_equal(sample_out.samples.elements[4], 0x800 + 4 * 300);
+    zassert_equal(sample_out.history[1].ratio, -0.5f);
+    zassert_equal(sample_out.meta.sequence, 0xDEADBEEF);
+    zassert_equal(sample_out.meta.tags.count, 2);
+    zassert_equal(sample_out.meta.tags.elements[1], 9);
+    zassert_equal(sample_out.value._tag_, 2);
+    zassert_equal(sample_out.value.text.count, 3);
+    zassert_mem_equal(sample_out.value.text.elements, "abc", 3);
+    zassert_true(sample_out.bits[0] && !sample_out.bits[1] && sample_out.bits[2]);
+    zassert_equal(sample_out.blob.count, sample.blob.count);
+    zassert_mem_equal(sample_out.blob.elements, sample.blob.elements, sample.blob.count);
+
+    size_t small = size - 1;
+    zassert_equal(ztest_Sample_1_0_serialize(&sample, buf, &small), -EMSGSIZE);
+}
+
+ZTEST(dsdl, chunks) {
+    static uint8_t whole[ztest_Sample_1_0_MAX_SIZE_BYTES];
+    size_t size = sizeof(whole);
+    zassert_ok(ztest_Sample_1_0_serialize(&sample, whole, &size));
+
+    /* Chunks of any size put together give the whole serialized object. */
+    uint8_t chunk[64];
+    for (size_t n = 1; n <= sizeof(chunk); n++) {
+        size_t offset = 0;
+        int32_t len;
+        while ((len = ztest_Sample_1_0_serialize_chunk(&sample, offset, chunk, n)) > 0) {
+            zassert_mem_equal(chunk, &whole[offset], len, "chunk size %zu", n);
+            offset += len;
+        }
+        zassert_ok(len);
+        zassert_equal(offset, size, "chunk size %zu", n);
+    }
+}
+
+ZTEST(dsdl, invalid) {
+    size_t size = sizeof(buf);
+    sample.samples.count = ARRAY_SIZE(sample.samples.elements) + 1;
+    zassert_equal(ztest_Sample_1_0_serialize(&sample, buf, &size), -EINVAL);
+    zassert_equal(ztest_Sample_1_0_serialized_size(&sample), -EINVAL);
+    sample.samples.count = 0;
+    sample.value._tag_ = 3;
+    zassert_equal(ztest_Sample_1_0_serialize_chunk(&sample, 0, buf, size), -EINVAL);
+
+    /* A length beyond the capacity is rejected. */
+    const uint8_t request[] = {0x01, 0x01, 0xAA};
+    ztest_Echo_Request_1_0 echo;
+    size = sizeof(request);
+    zassert_equal(ztest_Echo_Request_1_0_deserialize(&echo, request, &size), -EBADMSG);
+}
+
+struct rx_record {
+    size_t count;
+    size_t len;
+    uint8_t payload[CONFIG_ZYPHAL_RX_EXTENT_MAX];
+};
+
+static void rx_record_cb(const zyphal_rx_transfer_t* transfer, void* user_data) {
+    struct rx_record* record = (struct rx_record*)user_data;
+    record->count++;
+    record->len = transfer->payload_len;
+    memcpy(record->payload, transfer->payload, transfer->payload_len);
+}
+
+static void publish_done_cb(void* user_data, int32_t status) {
+    zassert_ok(status);
+    k_sem_give((struct k_sem*)user_data);
+}
+
+ZTEST(dsdl, publish) {
+    static struct rx_record record;
+    zyphal_sub_t sub;
+    zassert_ok(zyphal_subscribe(
+        &inst, &sub, SUBJECT_ID, sizeof(record.payload), rx_record_cb, &record));
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 1));
+
+    /* Serialized frame by frame, the transfer carries the serialized object. */
+    sample.blob.count = 100;
+    size_t size = sizeof(buf);
+    zassert_ok(ztest_Sample_1_0_serialize(&sample, buf, &size));
+    zassert_true(size > 64 && size <= sizeof(record.payload));
+    zassert_ok(ztest_Sample_1_0_publish(&tx,
+                                        ZYPHAL_PRIO_NOMINAL,
+                                        SUBJECT_ID,
+                                        &sample,
+                                        K_MSEC(10),
+                                        publish_done_cb,
+                                        &sem));
+    zassert_ok(k_sem_take(&sem, K_FOREVER));
+    can_fff_history_loopback();
+
+    zassert_equal(record.count, 1);
+    zassert_true(record.len >= size);
+    zassert_mem_equal(record.payload, buf, size);
+    zassert_ok(ztest_Sample_1_0_deserialize(&sample_out, record.payload, &record.len));
+    zassert_equal(sample_out.meta.sequence, sample.meta.sequence);
+    zassert_equal(sample_out.blob.count, 100);
+
+    sample.samples.count = ARRAY_SIZE(sample.samples.elements) + 1;
+    zassert_equal(ztest_Sample_1_0_publish(&tx,
+                                           ZYPHAL_PRIO_NOMINAL,
+                                           SUBJECT_ID,
+                                           &sample,
+                                           K_MSEC(10),
+                                           NULL,
+                                           NULL),
+                  -EINVAL);
+    zassert_ok(zyphal_unsubscribe(&sub));
+}
+
+ZTEST_SUITE(dsdl, NULL, NULL, dsdl_suite_before, NULL, NULL);
@@ -0,0 +1,179 @@
+#include <stdint.h>
+#include <zephyr/drivers/can/can_fake.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "can_fff.h"
+#include "frame.h"
+#include "zyphal/core.h"
+
+#define NODE_ID (0x55)
+#define REMOTE_NODE_ID (0x12)
+
+static const struct device* canbus = DEVICE_DT_GET(DT_NODELABEL(fake_can));
+static zyphal_inst_t inst;
+
+static uint32_t message_canid(uint16_t subject_id) {
+    return make_canid(
+        ZYPHAL_PRIO_NOMINAL, false, false, 0, subject_id, 0, REMOTE_NODE_ID);
+}
+
+static bool subject_in_set(const uint16_t* subjects, size_t count, uint16_t subject) {
+    for (size_t i = 0; i < count; i++) {
+        if (subjects[i] == subject) { return true; }
+    }
+    return false;
+}
+
+static void rx_ignore_cb(const zyphal_rx_transfer_t* transfer, void* user_data) {}
+
+/* Subscribes to a subject set on a controller with the given number of filters, asserts
+ * every subscribed subject passes the installed filters and returns the number of
+ * unsubscribed subjects that also pass. */
+static size_t subscribe_false_positives(const uint16_t* subjects,
+                                        size_t count,
+                                        size_t slots) {
+    static zyphal_sub_t subs[32];
+    zassert_true(count <= ARRAY_SIZE(subs));
+
+    fake_can_get_max_filters_fake.return_val = slots;
+    zassert_ok(zyphal_init(&inst, canbus, NODE_ID));
+    for (size_t i = 0; i < count; i++) {
+        zassert_ok(zyphal_subscribe(&inst, &subs[i], subjects[i], 8, rx_ignore_cb, NULL));
+    }
+    zassert_true(can_fff_filter_count() <= slots);
+
+    size_t false_positives = 0;
+    for (uint16_t subject = 0; subject <= ZYPHAL_MAX_SUBJECT_ID; subject++) {
+        bool accepted = can_fff_filter_accepts(message_canid(subject));
+
+        if (subject_in_set(subjects, count, subject)) {
+            zassert_true(accepted, "Subscribed subject %u rejected.", subject);
+        } else if (accepted) {
+            false_positives++;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) { zassert_ok(zyphal_unsubscribe(&subs[i])); }
+    zassert_equal(can_fff_filter_count(), 0);
+    return false_positives;
+}
+
+static void report_false_positives(const char* name,
+                                   const uint16_t* subjects,
+                                   size_t count) {
+    const size_t slots[] = {1, 2, 4, 8};
+    for (size_t i = 0; i < ARRAY_SIZE(slots); i++) {
+        size_t fp = subscribe_false_positives(subjects, count, slots[i]);
+        TC_PRINT("%s: %zu subjects, %zu slots, %zu false positive subjects\n",
+                 name,
+                 count,
+                 slots[i],
+                 fp);
+        if (slots[i] >= count) { zassert_equal(fp, 0); }
+    }
+}
+
+static void filter_suite_before(void* f) {
+    can_fff_ztest_before();
+}
+
+ZTEST(filter, plan_standard_node) {
+    /* Standard node subjects plus a few application subjects. */
+    const uint16_t subjects[] = {
+        7509, 7510, 8184, 100, 101, 102, 103, 200, 201, 1000, 1001, 1002};
+    report_false_positives("standard_node", subjects, ARRAY_SIZE(subjects));
+}
+
+ZTEST(filter, plan_contiguous_block) {
+    uint16_t subjects[32];
+    for (size_t i = 0; i < ARRAY_SIZE(subjects); i++) { subjects[i] = 1024 + i; }
+    report_false_positives("contiguous_block", subjects, ARRAY_SIZE(subjects));
+
+    /* An aligned block merges into a single exact filter. */
+    zassert_equal(subscribe_false_positives(subjects, ARRAY_SIZE(subjects), 1), 0);
+}
+
+ZTEST(filter, plan_scattered) {
+    uint16_t subjects[16];
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < ARRAY_SIZE(subjects); i++) {
+        do {
+            seed = seed * 1103515245 + 12345;
+            subjects[i] = (seed >> 16) % (ZYPHAL_MAX_SUBJECT_ID + 1);
+        } while (subject_in_set(subjects, i, subjects[i]));
+    }
+    report_false_positives("scattered", subjects, ARRAY_SIZE(subjects));
+}
+
+struct rx_count {
+    size_t count;
+    uint16_t port_id;
+};
+
+static void rx_count_cb(const zyphal_rx_transfer_t* transfer, void* user_data) {
+    struct rx_count* count = (struct rx_count*)user_data;
+    count->count++;
+    count->port_id = transfer->port_id;
+}
+
+static void rx_subject(uint16_t subject, uint8_t transfer_id) {
+    can_fff_rx_frame((struct can_frame){.id = message_canid(subject),
+                                        .flags = CAN_FRAME_IDE,
+                                        .dlc = 2,
+                                        .data = {0x01, 0xE0 | transfer_id}});
+}
+
+ZTEST(filter, subscriptions_share_slots) {
+    zassert_ok(zyphal_init(&inst, canbus, NODE_ID));
+
+    zyphal_sub_t subs[CONFIG_ZYPHAL_RX_FILTER_SLOTS * 2];
+    struct rx_count counts[ARRAY_SIZE(subs)] = {0};
+    for (size_t i = 0; i < ARRAY_SIZE(subs); i++) {
+        zassert_ok(
+            zyphal_subscribe(&inst, &subs[i], 100 + 3 * i, 8, rx_count_cb, &counts[i]));
+        zassert_true(can_fff_filter_count() <= CONFIG_ZYPHAL_RX_FILTER_SLOTS);
+    }
+
+    /* Every subscription still receives only its own subject. */
+    for (size_t i = 0; i < ARRAY_SIZE(subs); i++) { rx_subject(100 + 3 * i, 0); }
+    for (size_t i = 0; i < ARRAY_SIZE(subs); i++) {
+        zassert_equal(counts[i].count, 1);
+        zassert_equal(counts[i].port_id, 100 + 3 * i);
+    }
+
+    /* Subjects passed by merged filters are rejected in software. */
+    for (size_t i = 0; i < ARRAY_SIZE(subs); i++) { rx_subject(101 + 3 * i, 1); }
+    for (size_t i = 0; i < ARRAY_SIZE(subs); i++) { zassert_equal(counts[i].count, 1); }
+
+    /* Removing subscriptions releases or narrows their slots. */
+    for (size_t i = 1; i < ARRAY_SIZE(subs); i++) {
+        zassert_ok(zyphal_unsubscribe(&subs[i]));
+    }
+    zassert_equal(can_fff_filter_count(), 1);
+    rx_subject(100, 2);
+    rx_subject(101, 2);
+    zassert_equal(counts[0].count, 2);
+
+    zassert_ok(zyphal_unsubscribe(&subs[0]));
+    zassert_equal(can_fff_filter_count(), 0);
+}
+
+ZTEST(filter, controller_filter_limit) {
+    /* The controller's own filter count limits the plan below the Kconfig budget. */
+    fake_can_get_max_filters_fake.return_val = 2;
+    zassert_ok(zyphal_init(&inst, canbus, NODE_ID));
+
+    zyphal_sub_t subs[6];
+    struct rx_count counts[ARRAY_SIZE(subs)] = {0};
+    for (size_t i = 0; i < ARRAY_SIZE(subs); i++) {
+        zassert_ok(
+            zyphal_subscribe(&inst, &subs[i], 7000 + 50 * i, 8, rx_count_cb, &counts[i]));
+    }
+    zassert_equal(can_fff_filter_count(), 2);
+
+    for (size_t i = 0; i < ARRAY_SIZE(subs); i++) { rx_subject(7000 + 50 * i, 0); }
+    for (size_t i = 0; i < ARRAY_SIZE(subs); i++) { zassert_equal(counts[i].count, 1); }
+}
+
+ZTEST_SUITE(filter, NULL, NULL, filter_suite_before, NULL, NULL);
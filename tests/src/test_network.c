@@ -0,0 +1,165 @@
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "can_vbus.h"
+#include "zyphal/core.h"
+
+#define NODES (4)
+#define SUBJECT_ID (0x1234)
+
+#define FILL_VAL(len, val) ((uint8_t)(val))
+#define FILL_ARRAY(len, val) LISTIFY(len, FILL_VAL, (, ), val)
+
+BUILD_ASSERT(NODES <= CAN_VBUS_NODES);
+
+/* Nodes on the virtual bus, node i with node ID i + 1. */
+static zyphal_inst_t insts[NODES];
+
+struct rx_record {
+    size_t count;
+    zyphal_rx_transfer_t transfer;
+    uint8_t payload[CONFIG_ZYPHAL_RX_EXTENT_MAX];
+};
+
+static void rx_record_cb(const zyphal_rx_transfer_t* transfer, void* user_data) {
+    struct rx_record* record = (struct rx_record*)user_data;
+    record->count++;
+    record->transfer = *transfer;
+    memcpy(record->payload, transfer->payload, transfer->payload_len);
+}
+
+static uint8_t monitor_sources[8];
+static size_t monitor_count;
+
+static void monitor_record(size_t node, const struct can_frame* frame) {
+    if (monitor_count < ARRAY_SIZE(monitor_sources)) {
+        monitor_sources[monitor_count++] = frame->id & 0x7F;
+    }
+}
+
+static void network_suite_before(void* f) {
+    can_vbus_reset();
+    monitor_count = 0;
+    for (size_t i = 0; i < NODES; i++) {
+        zassert_ok(zyphal_init(&insts[i], can_vbus_node(i), i + 1));
+    }
+}
+
+ZTEST(network, publish_to_subscribers) {
+    zyphal_sub_t subs[NODES];
+    static struct rx_record records[NODES];
+    memset(records, 0, sizeof(records));
+    for (size_t i = 1; i < NODES; i++) {
+        zassert_ok(zyphal_subscribe(&insts[i],
+                                    &subs[i],
+                                    SUBJECT_ID,
+                                    sizeof(records[i].payload),
+                                    rx_record_cb,
+                                    &records[i]));
+    }
+
+    /* Every other node receives the transfer, frames are delivered before the sender
+     * completes them. */
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&insts[0], &tx));
+    uint8_t pl[] = {FILL_ARRAY(187, 0x33)};
+    zassert_ok(zyphal_publish_wait(
+        &tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, sizeof(pl), K_MSEC(100)));
+    for (size_t i = 1; i < NODES; i++) {
+        zassert_equal(records[i].count, 1);
+        zassert_equal(records[i].transfer.source_node_id, 1);
+        zassert_equal(records[i].transfer.payload_len, sizeof(pl));
+        zassert_mem_equal(records[i].payload, pl, sizeof(pl));
+    }
+
+    struct can_vbus_stats stats;
+    can_vbus_stats_get(&stats);
+    zassert_equal(stats.frames, 3);
+    zassert_equal(stats.errors, 0);
+}
+
+ZTEST(network, arbitration) {
+    zyphal_tx_t txs[NODES];
+    for (size_t i = 0; i < NODES; i++) { zassert_ok(zyphal_tx_init(&insts[i], &txs[i])); }
+    can_vbus_set_monitor(monitor_record);
+    /* At 10 kbit/s a two byte frame occupies the bus for about 10 ms. */
+    can_vbus_set_bitrate(10000, 10000);
+
+    /* The first frame takes the idle bus, the others are then sent by priority whatever
+     * order they were published in. */
+    uint8_t pl[] = {1};
+    zassert_ok(zyphal_publish(
+        &txs[0], ZYPHAL_PRIO_OPTIONAL, SUBJECT_ID, pl, 1, K_SECONDS(1), NULL, NULL));
+    k_sleep(K_MSEC(1));
+    const zyphal_prio_t priorities[] = {
+        ZYPHAL_PRIO_LOW, ZYPHAL_PRIO_HIGH, ZYPHAL_PRIO_NOMINAL};
+    for (size_t i = 1; i < NODES; i++) {
+        zassert_ok(zyphal_publish(
+            &txs[i], priorities[i - 1], SUBJECT_ID, pl, 1, K_SECONDS(1), NULL, NULL));
+    }
+    k_sleep(K_MSEC(100));
+
+    zassert_equal(monitor_count, 4);
+    zassert_mem_equal(monitor_sources, ((uint8_t[]){1, 3, 4, 2}), 4);
+}
+
+ZTEST(network, error_retransmission) {
+    zyphal_sub_t sub;
+    static struct rx_record record;
+    memset(&record, 0, sizeof(record));
+    zassert_ok(zyphal_subscribe(
+        &insts[1], &sub, SUBJECT_ID, sizeof(record.payload), rx_record_cb, &record));
+
+    /* Every second transmission is destroyed, and repeated by the controller without
+     * the stack noticing. */
+    can_vbus_set_error_rate(2);
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&insts[0], &tx));
+    uint8_t pl[] = {FILL_ARRAY(187, 0x44)};
+    zassert_ok(zyphal_publish_wait(
+        &tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, sizeof(pl), K_MSEC(100)));
+    zassert_equal(record.count, 1);
+    zassert_mem_equal(record.payload, pl, sizeof(pl));
+
+    struct can_vbus_stats stats;
+    can_vbus_stats_get(&stats);
+    zassert_equal(stats.frames, 3);
+    zassert_equal(stats.errors, 2);
+}
+
+ZTEST(network, overlapping_filters) {
+    /* More ports than filter slots, in an order where widened slots pass ports of
+     * other slots. */
+    static const uint16_t ports[] = {30, 17, 18, 1, 23, 27, 24, 13, 5, 0};
+    BUILD_ASSERT(ARRAY_SIZE(ports) > CONFIG_ZYPHAL_RX_FILTER_SLOTS);
+    static zyphal_sub_t subs[ARRAY_SIZE(ports)];
+    static struct rx_record records[ARRAY_SIZE(ports)];
+    memset(records, 0, sizeof(records));
+    for (size_t i = 0; i < ARRAY_SIZE(ports); i++) {
+        zassert_ok(zyphal_subscribe(&insts[1],
+                                    &subs[i],
+                                    ports[i],
+                                    sizeof(records[i].payload),
+                                    rx_record_cb,
+                                    &records[i]));
+    }
+
+    /* Every multi frame transfer is delivered exactly once. */
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&insts[0], &tx));
+    uint8_t pl[] = {FILL_ARRAY(187, 0x55)};
+    for (size_t i = 0; i < ARRAY_SIZE(ports); i++) {
+        zassert_ok(zyphal_publish_wait(
+            &tx, ZYPHAL_PRIO_NOMINAL, ports[i], pl, sizeof(pl), K_MSEC(100)));
+        zassert_equal(records[i].count, 1, "port %u", ports[i]);
+        zassert_equal(records[i].transfer.payload_len, sizeof(pl));
+        zassert_mem_equal(records[i].payload, pl, sizeof(pl));
+    }
+
+    struct can_vbus_stats stats;
+    can_vbus_stats_get(&stats);
+    zassert_equal(stats.frames, 3 * ARRAY_SIZE(ports));
+}
+
+ZTEST_SUITE(network, NULL, NULL, network_suite_before, NULL, NULL);
@@ -0,0 +1,202 @@
+#include <stdint.h>
+#include <zephyr/drivers/can/can_fake.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "can_fff.h"
+#include "zyphal/core.h"
+
+#define NODE_ID (0x55)
+#define SUBJECT_ID (0x1234)
+
+static const struct device* canbus = DEVICE_DT_GET(DT_NODELABEL(fake_can));
+static zyphal_inst_t inst;
+
+static int32_t counter_cb(uint8_t* payload, size_t size, void* user_data) {
+    uint8_t* counter = (uint8_t*)user_data;
+    payload[0] = (*counter)++;
+    return 1;
+}
+
+static int32_t skip_cb(uint8_t* payload, size_t size, void* user_data) {
+    return -1;
+}
+
+static void periodic_suite_before(void* f) {
+    zassert_true(device_is_ready(canbus));
+    zassert_ok(zyphal_init(&inst, canbus, NODE_ID));
+
+    can_fff_ztest_before();
+}
+
+ZTEST(periodic, publish_every_period) {
+    zyphal_periodic_t per;
+    uint8_t buffer[1];
+    uint8_t counter = 0;
+    zassert_ok(zyphal_periodic_start(&inst,
+                                     &per,
+                                     ZYPHAL_PRIO_NOMINAL,
+                                     SUBJECT_ID,
+                                     K_MSEC(10),
+                                     K_MSEC(5),
+                                     buffer,
+                                     sizeof(buffer),
+                                     counter_cb,
+                                     &counter));
+    k_sleep(K_MSEC(55));
+    zassert_ok(zyphal_periodic_stop(&per));
+    zassert_equal(zyphal_periodic_stop(&per), -EALREADY);
+
+    zyphal_periodic_stats_t stats;
+    zassert_ok(zyphal_periodic_stats_get(&per, &stats));
+    zassert_between_inclusive(stats.published, 5, 6);
+    zassert_equal(stats.missed, 0);
+    zassert_true(stats.jitter_max >= stats.jitter_last);
+
+    /* Each release builds a new payload, sent with the next transfer ID. */
+    zassert_equal(counter, stats.published);
+    for (uint8_t i = 0; i < stats.published; i++) {
+        can_fff_assert_popped_frame_equal(
+            (struct can_frame){.id = 0x10723455, .dlc = 2, .data = {i, 0xE0 | i}});
+    }
+    can_fff_assert_frames_empty();
+}
+
+ZTEST(periodic, spread_phases) {
+    zyphal_periodic_t pers[4];
+    uint8_t buffer[1];
+    for (size_t i = 0; i < ARRAY_SIZE(pers); i++) {
+        zassert_ok(zyphal_periodic_start(&inst,
+                                         &pers[i],
+                                         ZYPHAL_PRIO_NOMINAL,
+                                         SUBJECT_ID + i,
+                                         K_MSEC(10),
+                                         K_MSEC(10),
+                                         buffer,
+                                         sizeof(buffer),
+                                         skip_cb,
+                                         NULL));
+    }
+
+    /* Publishers of equal periods are released in different slots. */
+    for (size_t i = 0; i < ARRAY_SIZE(pers); i++) {
+        for (size_t j = i + 1; j < ARRAY_SIZE(pers); j++) {
+            zassert_not_equal(pers[i].release, pers[j].release);
+        }
+    }
+
+    /* Skipped periods publish nothing, and are not missed. */
+    k_sleep(K_MSEC(25));
+    for (size_t i = 0; i < ARRAY_SIZE(pers); i++) {
+        zyphal_periodic_stats_t stats;
+        zassert_ok(zyphal_periodic_stats_get(&pers[i], &stats));
+        zassert_equal(stats.published, 0);
+        zassert_equal(stats.missed, 0);
+        zassert_ok(zyphal_periodic_stop(&pers[i]));
+    }
+    can_fff_assert_frames_empty();
+}
+
+ZTEST(periodic, failed_transfers) {
+    zyphal_periodic_t per;
+    uint8_t buffer[1];
+    uint8_t counter = 0;
+
+    /* Messages the CAN driver fails to send count as missed. */
+    can_fff_set_send_status(-ENETDOWN);
+    zassert_ok(zyphal_periodic_start(&inst,
+                                     &per,
+                                     ZYPHAL_PRIO_NOMINAL,
+                                     SUBJECT_ID,
+                                     K_MSEC(10),
+                                     K_MSEC(5),
+                                     buffer,
+                                     sizeof(buffer),
+                                     counter_cb,
+                                     &counter));
+    k_sleep(K_MSEC(35));
+    zassert_ok(zyphal_periodic_stop(&per));
+    can_fff_set_send_status(0);
+
+    zyphal_periodic_stats_t stats;
+    zassert_ok(zyphal_periodic_stats_get(&per, &stats));
+    zassert_true(stats.published >= 3);
+    zassert_equal(stats.missed, stats.published);
+}
+
+ZTEST(periodic, errors) {
+    zyphal_periodic_t per;
+    uint8_t buffer[1];
+
+    zassert_equal(zyphal_periodic_start(NULL,
+                                        &per,
+                                        ZYPHAL_PRIO_NOMINAL,
+                                        SUBJECT_ID,
+                                        K_MSEC(10),
+                                        K_MSEC(10),
+                                        buffer,
+                                        sizeof(buffer),
+                                        counter_cb,
+                                        NULL),
+                  -EINVAL);
+    zassert_equal(zyphal_periodic_start(&inst,
+                                        &per,
+                                        ZYPHAL_PRIO_NOMINAL,
+                                        SUBJECT_ID,
+                                        K_NO_WAIT,
+                                        K_MSEC(10),
+                                        buffer,
+                                        sizeof(buffer),
+                                        counter_cb,
+                                        NULL),
+                  -EINVAL);
+    zassert_equal(zyphal_periodic_start(&inst,
+                                        &per,
+                                        ZYPHAL_PRIO_NOMINAL,
+                                        SUBJECT_ID,
+                                        K_MSEC(10),
+                                        K_FOREVER,
+                                        buffer,
+                                        sizeof(buffer),
+                                        counter_cb,
+                                        NULL),
+                  -EINVAL);
+    zassert_equal(zyphal_periodic_start(&inst,
+                                        &per,
+                                        ZYPHAL_PRIO_NOMINAL,
+                                        ZYPHAL_MAX_SUBJECT_ID + 1,
+                                        K_MSEC(10),
+                                        K_MSEC(10),
+                                        buffer,
+                                        sizeof(buffer),
+                                        counter_cb,
+                                        NULL),
+                  -EINVAL);
+    zassert_equal(zyphal_periodic_stats_get(NULL, NULL), -EINVAL);
+
+    /* Already running. */
+    zassert_ok(zyphal_periodic_start(&inst,
+                                     &per,
+                                     ZYPHAL_PRIO_NOMINAL,
+                                     SUBJECT_ID,
+                                     K_MSEC(10),
+                                     K_MSEC(10),
+                                     buffer,
+                                     sizeof(buffer),
+                                     skip_cb,
+                                     NULL));
+    zassert_equal(zyphal_periodic_start(&inst,
+                                        &per,
+                                        ZYPHAL_PRIO_NOMINAL,
+                                        SUBJECT_ID,
+                                        K_MSEC(10),
+                                        K_MSEC(10),
+                                        buffer,
+                                        sizeof(buffer),
+                                        skip_cb,
+                                        NULL),
+                  -EALREADY);
+    zassert_ok(zyphal_periodic_stop(&per));
+}
+
+ZTEST_SUITE(periodic, NULL, NULL, periodic_suite_before, NULL, NULL);
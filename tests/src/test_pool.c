@@ -0,0 +1,162 @@
+#include <stdint.h>
+#include <zephyr/drivers/can/can_fake.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "can_fff.h"
+#include "zyphal/core.h"
+
+#define NODE_ID (0x55)
+#define SUBJECT_ID (0x1234)
+
+/* Small payloads of every transmitter but one overflow the small blocks. */
+BUILD_ASSERT(CONFIG_ZYPHAL_TX_POOL_TRANSFERS - 1 > CONFIG_ZYPHAL_TX_POOL_SMALL_COUNT);
+BUILD_ASSERT(CONFIG_ZYPHAL_TX_POOL_TRANSFERS - 1 <=
+             CONFIG_ZYPHAL_TX_POOL_SMALL_COUNT + CONFIG_ZYPHAL_TX_POOL_MEDIUM_COUNT);
+
+static const struct device* canbus = DEVICE_DT_GET(DT_NODELABEL(fake_can));
+static zyphal_inst_t inst;
+
+static void pool_done_cb(void* user_data, int32_t status) {
+    struct k_sem* sem = (struct k_sem*)user_data;
+    zassert_ok(status);
+    k_sem_give(sem);
+}
+
+/* Completes frames held in flight until the transmitter has nothing left to send. */
+static void complete_all_deferred(void) {
+    k_sleep(K_MSEC(1));
+    while (can_fff_deferred_count() > 0) {
+        can_fff_complete_deferred(can_fff_deferred_count());
+        k_sleep(K_MSEC(1));
+    }
+}
+
+static void pool_suite_before(void* f) {
+    zassert_true(device_is_ready(canbus));
+    zassert_ok(zyphal_init(&inst, canbus, NODE_ID));
+
+    can_fff_ztest_before();
+}
+
+ZTEST(pool, publish_copy) {
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 3));
+    can_fff_set_deferred_completion(true);
+
+    /* The payload buffer is reused right away, each transfer sends its own copy. */
+    uint8_t pl[1];
+    for (uint8_t i = 0; i < 3; i++) {
+        pl[0] = i;
+        zassert_ok(zyphal_publish_copy(&inst,
+                                       ZYPHAL_PRIO_NOMINAL,
+                                       SUBJECT_ID,
+                                       pl,
+                                       sizeof(pl),
+                                       K_MSEC(10),
+                                       pool_done_cb,
+                                       &sem));
+    }
+
+    zyphal_tx_pool_stats_t stats;
+    zassert_ok(zyphal_tx_pool_stats_get(&inst, &stats));
+    zassert_equal(stats.transfers_used, 3);
+    zassert_equal(stats.blocks_used[0], 3);
+
+    complete_all_deferred();
+    for (size_t i = 0; i < sem.limit; i++) { zassert_ok(k_sem_take(&sem, K_MSEC(10))); }
+    for (uint8_t i = 0; i < 3; i++) {
+        can_fff_assert_popped_frame_equal(
+            (struct can_frame){.id = 0x10723455, .dlc = 2, .data = {i, 0xE0 | i}});
+    }
+    can_fff_assert_frames_empty();
+
+    /* Pooled transfers continue the subject session of every other publish. */
+    can_fff_set_deferred_completion(false);
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+    pl[0] = 3;
+    zassert_ok(zyphal_publish_wait(
+        &tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, sizeof(pl), K_MSEC(10)));
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x10723455, .dlc = 2, .data = {3, 0xE3}});
+    can_fff_assert_frames_empty();
+
+    /* Everything is back in the pool, the watermarks remain. */
+    zassert_ok(zyphal_tx_pool_stats_get(&inst, &stats));
+    zassert_equal(stats.transfers_used, 0);
+    zassert_equal(stats.transfers_max, 3);
+    zassert_equal(stats.blocks_used[0], 0);
+    zassert_equal(stats.blocks_max[0], 3);
+    zassert_equal(stats.exhausted, 0);
+}
+
+ZTEST(pool, exhausted) {
+    static uint8_t pl[CONFIG_ZYPHAL_TX_POOL_LARGE_SIZE + 1];
+    can_fff_set_deferred_completion(true);
+
+    zassert_equal(zyphal_publish_copy(&inst,
+                                      ZYPHAL_PRIO_NOMINAL,
+                                      SUBJECT_ID,
+                                      pl,
+                                      sizeof(pl),
+                                      K_MSEC(10),
+                                      NULL,
+                                      NULL),
+                  -EMSGSIZE);
+
+    /* Only one large block, the second large payload finds no room. */
+    zassert_ok(zyphal_publish_copy(&inst,
+                                   ZYPHAL_PRIO_NOMINAL,
+                                   SUBJECT_ID,
+                                   pl,
+                                   CONFIG_ZYPHAL_TX_POOL_LARGE_SIZE,
+                                   K_MSEC(100),
+                                   NULL,
+                                   NULL));
+    zassert_equal(zyphal_publish_copy(&inst,
+                                      ZYPHAL_PRIO_NOMINAL,
+                                      SUBJECT_ID,
+                                      pl,
+                                      CONFIG_ZYPHAL_TX_POOL_MEDIUM_SIZE + 1,
+                                      K_MSEC(100),
+                                      NULL,
+                                      NULL),
+                  -ENOMEM);
+
+    /* Small payloads spill into medium blocks, until transmitters run out. */
+    size_t transfers = CONFIG_ZYPHAL_TX_POOL_TRANSFERS - 1;
+    for (size_t i = 0; i < transfers; i++) {
+        zassert_ok(zyphal_publish_copy(&inst,
+                                       ZYPHAL_PRIO_NOMINAL,
+                                       SUBJECT_ID,
+                                       pl,
+                                       1,
+                                       K_MSEC(100),
+                                       NULL,
+                                       NULL));
+    }
+    zassert_equal(zyphal_publish_copy(&inst,
+                                      ZYPHAL_PRIO_NOMINAL,
+                                      SUBJECT_ID,
+                                      pl,
+                                      1,
+                                      K_MSEC(100),
+                                      NULL,
+                                      NULL),
+                  -ENOMEM);
+
+    zyphal_tx_pool_stats_t stats;
+    zassert_ok(zyphal_tx_pool_stats_get(&inst, &stats));
+    zassert_equal(stats.transfers_used, CONFIG_ZYPHAL_TX_POOL_TRANSFERS);
+    zassert_equal(stats.blocks_used[0], CONFIG_ZYPHAL_TX_POOL_SMALL_COUNT);
+    zassert_equal(stats.blocks_used[1], transfers - CONFIG_ZYPHAL_TX_POOL_SMALL_COUNT);
+    zassert_equal(stats.blocks_used[2], 1);
+    zassert_equal(stats.exhausted, 2);
+
+    complete_all_deferred();
+    zassert_ok(zyphal_tx_pool_stats_get(&inst, &stats));
+    zassert_equal(stats.transfers_used, 0);
+}
+
+ZTEST_SUITE(pool, NULL, NULL, pool_suite_before, NULL, NULL);
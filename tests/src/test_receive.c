@@ -0,0 +1,382 @@
+#include <stdint.h>
+#include <zephyr/drivers/can/can_fake.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "can_fff.h"
+#include "transmit.h"
+#include "zyphal/core.h"
+
+#define NODE_ID (0x55)
+#define SUBJECT_ID (0x1234)
+
+#define FILL_VAL(len, val) ((uint8_t)(val))
+#define FILL_ARRAY(len, val) LISTIFY(len, FILL_VAL, (, ), val)
+
+static const struct device* canbus = DEVICE_DT_GET(DT_NODELABEL(fake_can));
+static const struct device* canbus_redundant =
+    DEVICE_DT_GET(DT_NODELABEL(fake_can_redundant));
+static zyphal_inst_t inst;
+
+struct rx_record {
+    size_t count;
+    zyphal_rx_transfer_t transfer;
+    uint8_t payload[CONFIG_ZYPHAL_RX_EXTENT_MAX];
+};
+
+static void rx_record_cb(const zyphal_rx_transfer_t* transfer, void* user_data) {
+    struct rx_record* record = (struct rx_record*)user_data;
+    record->count++;
+    record->transfer = *transfer;
+    memcpy(record->payload, transfer->payload, transfer->payload_len);
+}
+
+static void receive_suite_before(void* f) {
+    zassert_true(device_is_ready(canbus));
+    zassert_ok(zyphal_init(&inst, canbus, NODE_ID));
+
+    can_fff_ztest_before();
+}
+
+ZTEST(receive, single_frame_message) {
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 16, rx_record_cb, &record));
+
+    can_fff_rx_frame((struct can_frame){.id = 0x08723412,
+                                        .flags = CAN_FRAME_IDE,
+                                        .dlc = 4,
+                                        .data = {0x01, 0x02, 0x03, 0xE7}});
+    zassert_equal(record.count, 1);
+    zassert_equal(record.transfer.priority, ZYPHAL_PRIO_FAST);
+    zassert_equal(record.transfer.port_id, SUBJECT_ID);
+    zassert_equal(record.transfer.source_node_id, 0x12);
+    zassert_equal(record.transfer.transfer_id, 7);
+    zassert_equal(record.transfer.payload_len, 3);
+    zassert_mem_equal(record.payload, ((uint8_t[]){0x01, 0x02, 0x03}), 3);
+
+    /* Frames on other subjects are not delivered. */
+    can_fff_rx_frame((struct can_frame){
+        .id = 0x08723512, .flags = CAN_FRAME_IDE, .dlc = 2, .data = {0x01, 0xE8}});
+    zassert_equal(record.count, 1);
+}
+
+ZTEST(receive, anonymous_message) {
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 16, rx_record_cb, &record));
+
+    can_fff_rx_frame((struct can_frame){
+        .id = 0x11723477, .flags = CAN_FRAME_IDE, .dlc = 2, .data = {0xAA, 0xE0}});
+    zassert_equal(record.count, 1);
+    zassert_equal(record.transfer.source_node_id, ZYPHAL_NODE_ID_UNSET);
+    zassert_equal(record.transfer.payload_len, 1);
+    zassert_equal(record.payload[0], 0xAA);
+
+    /* Anonymous transfers can not span multiple frames. */
+    can_fff_rx_frame((struct can_frame){
+        .id = 0x11723477, .flags = CAN_FRAME_IDE, .dlc = 2, .data = {0xAA, 0xA1}});
+    zassert_equal(record.count, 1);
+}
+
+ZTEST(receive, multi_frame_loopback) {
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 256, rx_record_cb, &record));
+
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+
+    /* CRC split between frames, and CRC after padding. Padding is indistinguishable
+     * from payload, so it is received as part of the transfer. */
+    size_t lens[] = {187, 126, 125, 81};
+    size_t received_lens[] = {187, 126, 125, 84};
+    for (size_t i = 0; i < ARRAY_SIZE(lens); i++) {
+        uint8_t pl[256];
+        for (size_t b = 0; b < lens[i]; b++) { pl[b] = (uint8_t)(b * 7 + i); }
+
+        zassert_ok(zyphal_publish_wait(
+            &tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, lens[i], K_MSEC(10)));
+        can_fff_history_loopback();
+
+        zassert_equal(record.count, i + 1);
+        zassert_equal(record.transfer.source_node_id, NODE_ID);
+        zassert_equal(record.transfer.transfer_id, i);
+        zassert_equal(record.transfer.payload_len, received_lens[i]);
+        zassert_mem_equal(record.payload, pl, lens[i]);
+    }
+}
+
+ZTEST(receive, extent_truncation) {
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 10, rx_record_cb, &record));
+
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+
+    uint8_t pl[] = {FILL_ARRAY(187, 0x33)};
+    zassert_ok(zyphal_publish_wait(
+        &tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, sizeof(pl), K_MSEC(10)));
+    can_fff_history_loopback();
+
+    /* The CRC is still validated across the full transfer. */
+    zassert_equal(record.count, 1);
+    zassert_equal(record.transfer.payload_len, 10);
+    zassert_mem_equal(record.payload, pl, 10);
+}
+
+ZTEST(receive, invalid_transfers) {
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 256, rx_record_cb, &record));
+
+    struct can_frame first = {.id = 0x10723412,
+                              .flags = CAN_FRAME_IDE,
+                              .dlc = 15,
+                              .data = {FILL_ARRAY(63, 0x33), 0xA0}};
+    struct can_frame second = {.id = 0x10723412,
+                               .flags = CAN_FRAME_IDE,
+                               .dlc = 15,
+                               .data = {FILL_ARRAY(63, 0x33), 0x00}};
+    struct can_frame last = {.id = 0x10723412,
+                             .flags = CAN_FRAME_IDE,
+                             .dlc = 15,
+                             .data = {FILL_ARRAY(61, 0x33), 0x95, 0x90, 0x60}};
+
+    /* Corrupted CRC. */
+    struct can_frame bad_crc = last;
+    bad_crc.data[62] ^= 0xFF;
+    can_fff_rx_frame(first);
+    can_fff_rx_frame(second);
+    can_fff_rx_frame(bad_crc);
+    zassert_equal(record.count, 0);
+
+    /* Missing middle frame, detected by the toggle bit. */
+    first.data[63] = 0xA1;
+    last.data[63] = 0x61;
+    can_fff_rx_frame(first);
+    can_fff_rx_frame(last);
+    zassert_equal(record.count, 0);
+
+    /* Frames of another transfer ID are not appended. */
+    first.data[63] = 0xA2;
+    second.data[63] = 0x03;
+    can_fff_rx_frame(first);
+    can_fff_rx_frame(second);
+    zassert_equal(record.count, 0);
+
+    /* Valid transfer is still accepted afterwards. */
+    first.data[63] = 0xA4;
+    second.data[63] = 0x04;
+    last.data[63] = 0x64;
+    can_fff_rx_frame(first);
+    can_fff_rx_frame(second);
+    can_fff_rx_frame(last);
+    zassert_equal(record.count, 1);
+    zassert_equal(record.transfer.payload_len, 187);
+
+    /* A lost middle frame aborts its transfer, and the next transfer is received. */
+    first.data[63] = 0xA5;
+    last.data[63] = 0x65;
+    can_fff_rx_frame(first);
+    can_fff_rx_frame(last);
+    zassert_equal(record.count, 1);
+
+    first.data[63] = 0xA6;
+    second.data[63] = 0x06;
+    last.data[63] = 0x66;
+    can_fff_rx_frame(first);
+    can_fff_rx_frame(second);
+    can_fff_rx_frame(last);
+    zassert_equal(record.count, 2);
+    zassert_equal(record.transfer.transfer_id, 6);
+    zassert_equal(record.transfer.payload_len, 187);
+}
+
+ZTEST(receive, duplicate_transfer_id) {
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 16, rx_record_cb, &record));
+
+    struct can_frame frame = {
+        .id = 0x10723412, .flags = CAN_FRAME_IDE, .dlc = 2, .data = {0x01, 0xE3}};
+    can_fff_rx_frame(frame);
+    can_fff_rx_frame(frame);
+    zassert_equal(record.count, 1);
+
+    /* Same transfer ID from another source is a separate session. */
+    frame.id = 0x10723413;
+    can_fff_rx_frame(frame);
+    zassert_equal(record.count, 2);
+
+    /* Repeated transfer ID is accepted once the transfer ID timeout elapses. */
+    k_sleep(K_MSEC(CONFIG_ZYPHAL_RX_TRANSFER_ID_TIMEOUT_MS + 1));
+    can_fff_rx_frame(frame);
+    zassert_equal(record.count, 3);
+}
+
+ZTEST(receive, session_pool_exhausted) {
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 16, rx_record_cb, &record));
+
+    /* Every source beyond the pool size is dropped. */
+    for (uint8_t src = 0; src < CONFIG_ZYPHAL_RX_SESSIONS + 1; src++) {
+        can_fff_rx_frame((struct can_frame){.id = 0x10723400 | src,
+                                            .flags = CAN_FRAME_IDE,
+                                            .dlc = 2,
+                                            .data = {src, 0xE0}});
+    }
+    zassert_equal(record.count, CONFIG_ZYPHAL_RX_SESSIONS);
+
+    /* Idle sessions are reclaimed once they exceed the transfer ID timeout. */
+    k_sleep(K_MSEC(CONFIG_ZYPHAL_RX_TRANSFER_ID_TIMEOUT_MS + 1));
+    can_fff_rx_frame((struct can_frame){.id = 0x10723400 | CONFIG_ZYPHAL_RX_SESSIONS,
+                                        .flags = CAN_FRAME_IDE,
+                                        .dlc = 2,
+                                        .data = {0x00, 0xE0}});
+    zassert_equal(record.count, CONFIG_ZYPHAL_RX_SESSIONS + 1);
+}
+
+ZTEST(receive, unsubscribe) {
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 16, rx_record_cb, &record));
+
+    struct can_frame frame = {
+        .id = 0x10723412, .flags = CAN_FRAME_IDE, .dlc = 2, .data = {0x01, 0xE0}};
+    can_fff_rx_frame(frame);
+    zassert_equal(record.count, 1);
+
+    zassert_ok(zyphal_unsubscribe(&sub));
+    zassert_equal(zyphal_unsubscribe(&sub), -EALREADY);
+    frame.data[1] = 0xE1;
+    can_fff_rx_frame(frame);
+    zassert_equal(record.count, 1);
+}
+
+static K_SEM_DEFINE(rx_slow_sem, 0, 1);
+
+static void rx_slow_cb(const zyphal_rx_transfer_t* transfer, void* user_data) {
+    k_sem_take(&rx_slow_sem, K_FOREVER);
+    rx_record_cb(transfer, user_data);
+}
+
+static void rx_slow_release(struct k_timer* timer) {
+    k_sem_give(&rx_slow_sem);
+}
+
+ZTEST(receive, unsubscribe_running_callback) {
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 16, rx_slow_cb, &record));
+
+    /* The callback is still running when unsubscribing, which waits for it. */
+    can_fff_rx_frame((struct can_frame){
+        .id = 0x10723412, .flags = CAN_FRAME_IDE, .dlc = 2, .data = {0x01, 0xE0}});
+    zassert_equal(record.count, 0);
+
+    struct k_timer release;
+    k_timer_init(&release, rx_slow_release, NULL);
+    k_timer_start(&release, K_MSEC(5), K_NO_WAIT);
+    zassert_ok(zyphal_unsubscribe(&sub));
+    zassert_equal(record.count, 1);
+}
+
+ZTEST(receive, redundant_interfaces) {
+    zassert_ok(zyphal_iface_add(&inst, canbus_redundant));
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 256, rx_record_cb, &record));
+    zassert_equal(can_fff_filter_count(), 2);
+    zassert_equal(zyphal_iface_add(&inst, canbus_redundant), -EBUSY);
+
+    /* Frames arrive on both interfaces, the copy on the second is dropped. */
+    can_fff_rx_frame((struct can_frame){
+        .id = 0x10723412, .flags = CAN_FRAME_IDE, .dlc = 2, .data = {0x01, 0xE0}});
+    zassert_equal(record.count, 1);
+
+    /* Multi-frame transfers are reassembled once, from the first interface. */
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+    uint8_t pl[] = {FILL_ARRAY(187, 0x33)};
+    zassert_ok(zyphal_publish_wait(
+        &tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, sizeof(pl), K_MSEC(10)));
+    can_fff_history_loopback();
+    zassert_equal(record.count, 2);
+    zassert_equal(record.transfer.payload_len, 187);
+
+    zassert_ok(zyphal_unsubscribe(&sub));
+    zassert_equal(can_fff_filter_count(), 0);
+}
+
+static K_SEM_DEFINE(rx_block_sem, 0, 1);
+
+static void rx_block_handler(struct k_work* work) {
+    k_sem_take(&rx_block_sem, K_FOREVER);
+}
+
+ZTEST(receive, ring_overflow) {
+    zyphal_sub_t sub;
+    struct rx_record record = {0};
+    zassert_ok(zyphal_subscribe(&inst, &sub, SUBJECT_ID, 16, rx_record_cb, &record));
+
+    /* Frames wait in the ring while the work queue is held, the ones not fitting are
+     * dropped. */
+    struct k_work block;
+    k_work_init(&block, rx_block_handler);
+    zassert_true(k_work_submit_to_queue(zyphal_tx_workq(&inst), &block) > 0);
+    for (size_t i = 0; i < CONFIG_ZYPHAL_RX_RING_DEPTH + 2; i++) {
+        can_fff_rx_frame((struct can_frame){.id = 0x11723477,
+                                            .flags = CAN_FRAME_IDE,
+                                            .dlc = 2,
+                                            .data = {(uint8_t)i, 0xE0}});
+    }
+    zassert_equal(record.count, 0);
+
+    /* Once released, every frame in the ring is dispatched in one go. */
+    k_sem_give(&rx_block_sem);
+    k_sleep(K_MSEC(1));
+    zassert_equal(record.count, CONFIG_ZYPHAL_RX_RING_DEPTH);
+    zassert_equal(record.payload[0], CONFIG_ZYPHAL_RX_RING_DEPTH - 1);
+
+    zyphal_rx_stats_t stats;
+    zassert_ok(zyphal_rx_stats_get(&inst, &stats));
+    zassert_equal(stats.frames, CONFIG_ZYPHAL_RX_RING_DEPTH);
+    zassert_equal(stats.ring_overflows, 2);
+    zassert_equal(stats.ring_max, CONFIG_ZYPHAL_RX_RING_DEPTH);
+
+    /* The ring is usable again. */
+    can_fff_rx_frame((struct can_frame){
+        .id = 0x11723477, .flags = CAN_FRAME_IDE, .dlc = 2, .data = {0xAA, 0xE0}});
+    zassert_equal(record.count, CONFIG_ZYPHAL_RX_RING_DEPTH + 1);
+    zassert_equal(zyphal_rx_stats_get(&inst, NULL), -EINVAL);
+}
+
+ZTEST(receive, errors) {
+    zyphal_sub_t sub1;
+    zyphal_sub_t sub2;
+    struct rx_record record = {0};
+
+    zassert_equal(zyphal_subscribe(NULL, &sub1, SUBJECT_ID, 16, rx_record_cb, &record),
+                  -EINVAL);
+    zassert_equal(zyphal_subscribe(&inst, &sub1, SUBJECT_ID, 16, NULL, &record), -EINVAL);
+    zassert_equal(zyphal_subscribe(
+                      &inst, &sub1, ZYPHAL_MAX_SUBJECT_ID + 1, 16, rx_record_cb, &record),
+                  -EINVAL);
+    zassert_equal(zyphal_subscribe(&inst,
+                                   &sub1,
+                                   SUBJECT_ID,
+                                   CONFIG_ZYPHAL_RX_EXTENT_MAX + 1,
+                                   rx_record_cb,
+                                   &record),
+                  -EINVAL);
+
+    /* Only one subscription per subject. */
+    zassert_ok(zyphal_subscribe(&inst, &sub1, SUBJECT_ID, 16, rx_record_cb, &record));
+    zassert_equal(zyphal_subscribe(&inst, &sub2, SUBJECT_ID, 16, rx_record_cb, &record),
+                  -EALREADY);
+}
+
+ZTEST_SUITE(receive, NULL, NULL, receive_suite_before, NULL, NULL);
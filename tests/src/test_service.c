@@ -0,0 +1,435 @@
+#include <stdint.h>
+#include <zephyr/drivers/can/can_fake.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "can_fff.h"
+#include "zyphal/core.h"
+
+#define CLIENT_NODE_ID (0x55)
+#define SERVER_NODE_ID (0x12)
+#define SERVICE_ID (430)
+#define TAIL_TRANSFER_ID_COUNT (32)
+
+static const struct device* canbus = DEVICE_DT_GET(DT_NODELABEL(fake_can));
+static zyphal_inst_t client_inst;
+static zyphal_inst_t server_inst;
+
+/* Payloads must outlive their transfers, so these are not scoped to the assertions. */
+static uint8_t pl_one[] = {0x01};
+
+struct response_record {
+    size_t count;
+    int32_t status;
+    zyphal_rx_transfer_t transfer;
+    uint8_t payload[CONFIG_ZYPHAL_RX_EXTENT_MAX];
+};
+
+static void response_record_cb(const zyphal_rx_transfer_t* response,
+                               int32_t status,
+                               void* user_data) {
+    struct response_record* record = (struct response_record*)user_data;
+    record->count++;
+    record->status = status;
+    if (response) {
+        record->transfer = *response;
+        memcpy(record->payload, response->payload, response->payload_len);
+    }
+}
+
+/* Responds to each request with its payload incremented, from the receive callback. */
+struct echo_server {
+    zyphal_sub_t sub;
+    zyphal_tx_t tx[4];
+    size_t count;
+};
+
+static void echo_server_cb(const zyphal_rx_transfer_t* transfer, void* user_data) {
+    struct echo_server* server = (struct echo_server*)user_data;
+    zyphal_tx_t* tx = &server->tx[server->count++ % ARRAY_SIZE(server->tx)];
+
+    uint8_t pl[CONFIG_ZYPHAL_RX_EXTENT_MAX];
+    for (size_t i = 0; i < transfer->payload_len; i++) {
+        pl[i] = transfer->payload[i] + 1;
+    }
+    zassert_ok(zyphal_respond(tx,
+                              transfer->priority,
+                              transfer->port_id,
+                              transfer->source_node_id,
+                              transfer->transfer_id,
+                              pl,
+                              transfer->payload_len,
+                              K_MSEC(100),
+                              NULL,
+                              NULL));
+}
+
+static void echo_server_init(struct echo_server* server) {
+    server->count = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(server->tx); i++) {
+        zassert_ok(zyphal_tx_init(&server_inst, &server->tx[i]));
+    }
+    zassert_ok(
+        zyphal_serve(&server_inst, &server->sub, SERVICE_ID, 64, echo_server_cb, server));
+}
+
+struct request_log {
+    size_t count;
+    uint8_t transfer_ids[8];
+};
+
+static void request_log_cb(const zyphal_rx_transfer_t* transfer, void* user_data) {
+    struct request_log* log = (struct request_log*)user_data;
+    size_t i = log->count++ % ARRAY_SIZE(log->transfer_ids);
+    log->transfer_ids[i] = transfer->transfer_id;
+}
+
+/* Lets the transmit work run, then delivers everything sent to the bus. */
+static void bus_exchange(void) {
+    k_sleep(K_MSEC(1));
+    can_fff_history_loopback();
+}
+
+static void service_suite_before(void* f) {
+    zassert_true(device_is_ready(canbus));
+    zassert_ok(zyphal_init(&client_inst, canbus, CLIENT_NODE_ID));
+    zassert_ok(zyphal_init(&server_inst, canbus, SERVER_NODE_ID));
+
+    can_fff_ztest_before();
+}
+
+ZTEST(service, request_response) {
+    struct echo_server server;
+    echo_server_init(&server);
+
+    zyphal_client_t client;
+    zassert_ok(zyphal_client_init(&client_inst, &client, SERVICE_ID, 64));
+
+    zyphal_request_t req;
+    zassert_ok(zyphal_request_init(&client, &req));
+    struct response_record record = {0};
+
+    /* Multi-frame in both directions, and transfer IDs advancing per server. */
+    for (size_t i = 0; i < 3; i++) {
+        uint8_t pl[20];
+        for (size_t b = 0; b < sizeof(pl); b++) { pl[b] = (uint8_t)(b + i); }
+        zassert_ok(zyphal_request(&req,
+                                  ZYPHAL_PRIO_NOMINAL,
+                                  SERVER_NODE_ID,
+                                  pl,
+                                  sizeof(pl),
+                                  K_MSEC(100),
+                                  response_record_cb,
+                                  &record));
+
+        /* Request, then response. */
+        bus_exchange();
+        zassert_equal(server.count, i + 1);
+        bus_exchange();
+
+        zassert_equal(record.count, i + 1);
+        zassert_ok(record.status);
+        zassert_equal(record.transfer.port_id, SERVICE_ID);
+        zassert_equal(record.transfer.source_node_id, SERVER_NODE_ID);
+        zassert_equal(record.transfer.transfer_id, i);
+        zassert_true(record.transfer.payload_len >= sizeof(pl));
+        for (size_t b = 0; b < sizeof(pl); b++) {
+            zassert_equal(record.payload[b], pl[b] + 1);
+        }
+    }
+
+    /* Late duplicates of a response are not delivered again. */
+    zassert_ok(zyphal_respond(&server.tx[0],
+                              ZYPHAL_PRIO_NOMINAL,
+                              SERVICE_ID,
+                              CLIENT_NODE_ID,
+                              2,
+                              pl_one,
+                              1,
+                              K_MSEC(100),
+                              NULL,
+                              NULL));
+    bus_exchange();
+    zassert_equal(record.count, 3);
+
+    /* Transfer IDs belong to the instance session, so a new client of the service
+     * continues them. */
+    zassert_ok(zyphal_client_deinit(&client));
+    zassert_ok(zyphal_client_init(&client_inst, &client, SERVICE_ID, 64));
+    zassert_ok(zyphal_request_init(&client, &req));
+    zassert_ok(zyphal_request(&req,
+                              ZYPHAL_PRIO_NOMINAL,
+                              SERVER_NODE_ID,
+                              pl_one,
+                              1,
+                              K_MSEC(100),
+                              response_record_cb,
+                              &record));
+    bus_exchange();
+    bus_exchange();
+    zassert_equal(record.count, 4);
+    zassert_equal(record.transfer.transfer_id, 3);
+
+    zassert_ok(zyphal_client_deinit(&client));
+}
+
+ZTEST(service, session_table_full) {
+    struct echo_server server;
+    echo_server_init(&server);
+
+    /* Subjects take every session of the instance table. */
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&client_inst, &tx));
+    for (uint16_t i = 0; i < CONFIG_ZYPHAL_TX_SESSION_TABLE_SIZE - 1; i++) {
+        zassert_ok(
+            zyphal_publish_wait(&tx, ZYPHAL_PRIO_NOMINAL, i, pl_one, 1, K_MSEC(10)));
+    }
+    bus_exchange();
+
+    zyphal_client_t client;
+    zassert_ok(zyphal_client_init(&client_inst, &client, SERVICE_ID, 64));
+    zyphal_request_t req;
+    zassert_ok(zyphal_request_init(&client, &req));
+    struct response_record record = {0};
+
+    /* Requests then count transfer IDs per client. */
+    for (size_t i = 0; i < 2; i++) {
+        zassert_ok(zyphal_request(&req,
+                                  ZYPHAL_PRIO_NOMINAL,
+                                  SERVER_NODE_ID,
+                                  pl_one,
+                                  1,
+                                  K_MSEC(100),
+                                  response_record_cb,
+                                  &record));
+        bus_exchange();
+        bus_exchange();
+        zassert_equal(record.count, i + 1);
+        zassert_ok(record.status);
+        zassert_equal(record.transfer.transfer_id, i);
+    }
+
+    zassert_ok(zyphal_client_deinit(&client));
+}
+
+ZTEST(service, out_of_order_responses) {
+    struct request_log log = {0};
+    zyphal_sub_t server_sub;
+    zassert_ok(
+        zyphal_serve(&server_inst, &server_sub, SERVICE_ID, 64, request_log_cb, &log));
+
+    zyphal_client_t client;
+    zassert_ok(zyphal_client_init(&client_inst, &client, SERVICE_ID, 64));
+
+    zyphal_request_t reqs[3];
+    struct response_record records[3] = {0};
+    uint8_t request_pls[3] = {0, 1, 2};
+    for (size_t i = 0; i < ARRAY_SIZE(reqs); i++) {
+        zassert_ok(zyphal_request_init(&client, &reqs[i]));
+        zassert_ok(zyphal_request(&reqs[i],
+                                  ZYPHAL_PRIO_NOMINAL,
+                                  SERVER_NODE_ID,
+                                  &request_pls[i],
+                                  1,
+                                  K_MSEC(100),
+                                  response_record_cb,
+                                  &records[i]));
+    }
+    /* A request object is reused only once it completes. */
+    zassert_equal(zyphal_request(&reqs[0],
+                                 ZYPHAL_PRIO_NOMINAL,
+                                 SERVER_NODE_ID,
+                                 pl_one,
+                                 1,
+                                 K_MSEC(100),
+                                 response_record_cb,
+                                 &records[0]),
+                  -EALREADY);
+    bus_exchange();
+    zassert_equal(log.count, 3);
+
+    /* Responses are matched by transfer ID, in whatever order they arrive. */
+    uint8_t order[] = {2, 0, 1};
+    uint8_t response_pls[] = {0x10, 0x11, 0x12};
+    zyphal_tx_t txs[ARRAY_SIZE(order)];
+    for (size_t i = 0; i < ARRAY_SIZE(order); i++) {
+        zassert_ok(zyphal_tx_init(&server_inst, &txs[i]));
+        zassert_ok(zyphal_respond(&txs[i],
+                                  ZYPHAL_PRIO_NOMINAL,
+                                  SERVICE_ID,
+                                  CLIENT_NODE_ID,
+                                  log.transfer_ids[order[i]],
+                                  &response_pls[order[i]],
+                                  1,
+                                  K_MSEC(100),
+                                  NULL,
+                                  NULL));
+        bus_exchange();
+
+        size_t r = order[i];
+        zassert_equal(records[r].count, 1);
+        zassert_ok(records[r].status);
+        zassert_equal(records[r].payload[0], 0x10 + r);
+    }
+
+    zassert_ok(zyphal_client_deinit(&client));
+}
+
+ZTEST(service, timeout_and_cancel) {
+    struct request_log log = {0};
+    zyphal_sub_t server_sub;
+    zassert_ok(
+        zyphal_serve(&server_inst, &server_sub, SERVICE_ID, 64, request_log_cb, &log));
+
+    zyphal_client_t client;
+    zassert_ok(zyphal_client_init(&client_inst, &client, SERVICE_ID, 64));
+
+    zyphal_request_t reqs[3];
+    struct response_record records[3] = {0};
+    k_timeout_t timeouts[] = {K_MSEC(20), K_MSEC(10), K_MSEC(100)};
+    for (size_t i = 0; i < ARRAY_SIZE(reqs); i++) {
+        zassert_ok(zyphal_request_init(&client, &reqs[i]));
+        zassert_ok(zyphal_request(&reqs[i],
+                                  ZYPHAL_PRIO_NOMINAL,
+                                  SERVER_NODE_ID,
+                                  pl_one,
+                                  1,
+                                  timeouts[i],
+                                  response_record_cb,
+                                  &records[i]));
+    }
+    bus_exchange();
+    zassert_equal(log.count, 3);
+
+    /* Expired in deadline order, without a response. */
+    k_sleep(K_MSEC(15));
+    zassert_equal(records[1].count, 1);
+    zassert_equal(records[1].status, -ETIMEDOUT);
+    zassert_equal(records[0].count, 0);
+    k_sleep(K_MSEC(10));
+    zassert_equal(records[0].count, 1);
+    zassert_equal(records[0].status, -ETIMEDOUT);
+
+    zassert_ok(zyphal_request_cancel(&reqs[2]));
+    zassert_equal(records[2].count, 1);
+    zassert_equal(records[2].status, -ECANCELED);
+    zassert_equal(zyphal_request_cancel(&reqs[2]), -EALREADY);
+
+    /* A request still being sent when it times out is dropped from the bus. */
+    can_fff_set_deferred_completion(true);
+    zassert_ok(zyphal_request(&reqs[1],
+                              ZYPHAL_PRIO_NOMINAL,
+                              SERVER_NODE_ID,
+                              pl_one,
+                              1,
+                              K_MSEC(10),
+                              response_record_cb,
+                              &records[1]));
+    k_sleep(K_MSEC(15));
+    zassert_equal(records[1].count, 2);
+    zassert_equal(records[1].status, -ETIMEDOUT);
+    zassert_false(zyphal_tx_pending(&reqs[1].tx));
+    can_fff_set_deferred_completion(false);
+    can_fff_complete_deferred(can_fff_deferred_count());
+    can_fff_history_reset();
+
+    /* A response after the request completed is dropped. */
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&server_inst, &tx));
+    zassert_ok(zyphal_respond(&tx,
+                              ZYPHAL_PRIO_NOMINAL,
+                              SERVICE_ID,
+                              CLIENT_NODE_ID,
+                              log.transfer_ids[0],
+                              pl_one,
+                              1,
+                              K_MSEC(100),
+                              NULL,
+                              NULL));
+    bus_exchange();
+    zassert_equal(records[0].count, 1);
+
+    /* Outstanding requests are canceled along with the client. */
+    zassert_ok(zyphal_request(&reqs[0],
+                              ZYPHAL_PRIO_NOMINAL,
+                              SERVER_NODE_ID,
+                              pl_one,
+                              1,
+                              K_MSEC(100),
+                              response_record_cb,
+                              &records[0]));
+    bus_exchange();
+    zassert_ok(zyphal_client_deinit(&client));
+    zassert_equal(records[0].count, 2);
+    zassert_equal(records[0].status, -ECANCELED);
+}
+
+ZTEST(service, errors) {
+    zyphal_client_t client;
+    zyphal_request_t req;
+    struct response_record record = {0};
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&server_inst, &tx));
+
+    zassert_equal(
+        zyphal_client_init(&client_inst, &client, ZYPHAL_MAX_SERVICE_ID + 1, 64),
+        -EINVAL);
+    zassert_equal(zyphal_respond(&tx,
+                                 ZYPHAL_PRIO_NOMINAL,
+                                 SERVICE_ID,
+                                 ZYPHAL_MAX_NODE_ID + 1,
+                                 0,
+                                 pl_one,
+                                 1,
+                                 K_MSEC(100),
+                                 NULL,
+                                 NULL),
+                  -EINVAL);
+
+    zassert_ok(zyphal_client_init(&client_inst, &client, SERVICE_ID, 64));
+    zassert_ok(zyphal_request_init(&client, &req));
+    zassert_equal(zyphal_request(&req,
+                                 ZYPHAL_PRIO_NOMINAL,
+                                 ZYPHAL_MAX_NODE_ID + 1,
+                                 pl_one,
+                                 1,
+                                 K_MSEC(100),
+                                 response_record_cb,
+                                 &record),
+                  -EINVAL);
+    zassert_equal(zyphal_request(&req,
+                                 ZYPHAL_PRIO_NOMINAL,
+                                 SERVER_NODE_ID,
+                                 pl_one,
+                                 1,
+                                 K_MSEC(100),
+                                 NULL,
+                                 NULL),
+                  -EINVAL);
+
+    /* Every transfer ID to a server awaiting a response. */
+    zyphal_request_t reqs[TAIL_TRANSFER_ID_COUNT + 1];
+    for (size_t i = 0; i < ARRAY_SIZE(reqs); i++) {
+        zassert_ok(zyphal_request_init(&client, &reqs[i]));
+        int32_t ret = zyphal_request(&reqs[i],
+                                     ZYPHAL_PRIO_NOMINAL,
+                                     SERVER_NODE_ID,
+                                     pl_one,
+                                     1,
+                                     K_MSEC(100),
+                                     response_record_cb,
+                                     &record);
+        zassert_equal(ret, i < TAIL_TRANSFER_ID_COUNT ? 0 : -EBUSY);
+    }
+    bus_exchange();
+
+    /* Only one client per service. */
+    zyphal_client_t client2;
+    zassert_equal(zyphal_client_init(&client_inst, &client2, SERVICE_ID, 64), -EALREADY);
+
+    zassert_ok(zyphal_client_deinit(&client));
+    zassert_equal(record.count, TAIL_TRANSFER_ID_COUNT);
+    zassert_equal(zyphal_client_deinit(&client), -EALREADY);
+}
+
+ZTEST_SUITE(service, NULL, NULL, service_suite_before, NULL, NULL);
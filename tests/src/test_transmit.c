@@ -16,6 +16,7 @@ DEFINE_FFF_GLOBALS;
 #define FILL_ARRAY(len, val) LISTIFY(len, FILL_VAL, (, ), val)
 
 const struct device* canbus = DEVICE_DT_GET(DT_NODELABEL(fake_can));
+const struct device* canbus_redundant = DEVICE_DT_GET(DT_NODELABEL(fake_can_redundant));
 zyphal_inst_t inst;
 
 static void transmit_suite_before(void* f) {
@@ -117,6 +118,230 @@ static void publish_done_cb(void* user_data, int32_t status) {
     k_sem_give(sem);
 }
 
+ZTEST(transmit, scatter_gather_message) {
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+
+    /* Fragment boundaries fall inside frames, across frames, and at the CRC. */
+    uint8_t header[] = {FILL_ARRAY(10, 0x33)};
+    uint8_t block[] = {FILL_ARRAY(100, 0x33)};
+    uint8_t trailer[] = {FILL_ARRAY(77, 0x33)};
+    zyphal_iov_t iov[] = {{.data = header, .len = sizeof(header)},
+                          {.data = NULL, .len = 0},
+                          {.data = block, .len = sizeof(block)},
+                          {.data = trailer, .len = sizeof(trailer)}};
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 1));
+    zassert_ok(zyphal_publish_v(&tx,
+                                ZYPHAL_PRIO_NOMINAL,
+                                SUBJECT_ID,
+                                iov,
+                                ARRAY_SIZE(iov),
+                                K_MSEC(10),
+                                publish_done_cb,
+                                &sem));
+    zassert_ok(k_sem_take(&sem, K_FOREVER));
+
+    /* Identical to the same payload published from a contiguous buffer. */
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0xA0}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0x00}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(61, 0x33), 0x95, 0x90, 0x60}});
+    can_fff_assert_frames_empty();
+
+    /* Fragments of a single frame transfer, followed by padding. */
+    iov[2].len = 2;
+    iov[3].len = 0;
+    zassert_ok(zyphal_publish_v(&tx,
+                                ZYPHAL_PRIO_NOMINAL,
+                                SUBJECT_ID,
+                                iov,
+                                ARRAY_SIZE(iov),
+                                K_MSEC(10),
+                                publish_done_cb,
+                                &sem));
+    zassert_ok(k_sem_take(&sem, K_FOREVER));
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 10, .data = {FILL_ARRAY(12, 0x33), 0, 0, 0, 0xE1}});
+    can_fff_assert_frames_empty();
+
+    /* Fragments without data. */
+    iov[1].len = 1;
+    zassert_equal(zyphal_publish_v(&tx,
+                                   ZYPHAL_PRIO_NOMINAL,
+                                   SUBJECT_ID,
+                                   iov,
+                                   ARRAY_SIZE(iov),
+                                   K_MSEC(10),
+                                   publish_done_cb,
+                                   &sem),
+                  -EINVAL);
+    zassert_equal(
+        zyphal_publish_v(
+            &tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, NULL, 1, K_MSEC(10), NULL, NULL),
+        -EINVAL);
+}
+
+struct payload_source {
+    uint8_t value;
+    size_t fetched;
+    size_t max_len;
+    /* Offset from which the source fails. */
+    size_t fail_offset;
+};
+
+static int32_t payload_source_cb(void* user_data,
+                                 size_t offset,
+                                 uint8_t* buf,
+                                 size_t len) {
+    struct payload_source* src = (struct payload_source*)user_data;
+    if (offset >= src->fail_offset) { return -EIO; }
+
+    zassert_equal(offset, src->fetched);
+    memset(buf, src->value, len);
+    src->fetched += len;
+    src->max_len = MAX(src->max_len, len);
+    return len;
+}
+
+static int32_t source_status;
+
+static void publish_source_done_cb(void* user_data, int32_t status) {
+    source_status = status;
+    k_sem_give((struct k_sem*)user_data);
+}
+
+ZTEST(transmit, payload_source) {
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 1));
+
+    /* Fetched one frame at a time, identical to the same payload from a buffer. */
+    struct payload_source src = {.value = 0x33, .fail_offset = SIZE_MAX};
+    zassert_ok(zyphal_publish_source(&tx,
+                                     ZYPHAL_PRIO_NOMINAL,
+                                     SUBJECT_ID,
+                                     187,
+                                     payload_source_cb,
+                                     &src,
+                                     K_MSEC(10),
+                                     publish_source_done_cb,
+                                     &sem));
+    zassert_ok(k_sem_take(&sem, K_FOREVER));
+    zassert_ok(source_status);
+    zassert_equal(src.fetched, 187);
+    zassert_equal(src.max_len, 63);
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0xA0}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0x00}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(61, 0x33), 0x95, 0x90, 0x60}});
+    can_fff_assert_frames_empty();
+
+    /* Single frame transfer, followed by padding. */
+    src = (struct payload_source){.value = 0x22, .fail_offset = SIZE_MAX};
+    zassert_ok(zyphal_publish_source(&tx,
+                                     ZYPHAL_PRIO_NOMINAL,
+                                     SUBJECT_ID,
+                                     32,
+                                     payload_source_cb,
+                                     &src,
+                                     K_MSEC(10),
+                                     publish_source_done_cb,
+                                     &sem));
+    zassert_ok(k_sem_take(&sem, K_FOREVER));
+    zassert_ok(source_status);
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x10723455,
+                           .dlc = 14,
+                           .data = {FILL_ARRAY(32, 0x22), FILL_ARRAY(15, 0), 0xE1}});
+    can_fff_assert_frames_empty();
+
+    /* A source error fails the transfer, frames already sent stay sent. */
+    src = (struct payload_source){.value = 0x33, .fail_offset = 63};
+    zassert_ok(zyphal_publish_source(&tx,
+                                     ZYPHAL_PRIO_NOMINAL,
+                                     SUBJECT_ID,
+                                     187,
+                                     payload_source_cb,
+                                     &src,
+                                     K_MSEC(10),
+                                     publish_source_done_cb,
+                                     &sem));
+    zassert_ok(k_sem_take(&sem, K_FOREVER));
+    zassert_equal(source_status, -EIO);
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0xA2}});
+    can_fff_assert_frames_empty();
+
+    zassert_equal(zyphal_publish_source(&tx,
+                                        ZYPHAL_PRIO_NOMINAL,
+                                        SUBJECT_ID,
+                                        187,
+                                        NULL,
+                                        NULL,
+                                        K_MSEC(10),
+                                        NULL,
+                                        NULL),
+                  -EINVAL);
+}
+
+ZTEST(transmit, frame_cache) {
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+    struct can_frame cache[3];
+    zassert_ok(zyphal_tx_cache_set(&tx, cache, ARRAY_SIZE(cache)));
+
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 1));
+    zassert_equal(zyphal_republish(&tx, K_MSEC(10), publish_done_cb, &sem), -ENOENT);
+
+    /* Published, republished unchanged, and replayed without a payload. Only the
+     * transfer ID differs between the cached frames. */
+    uint8_t pl1[] = {FILL_ARRAY(187, 0x33)};
+    zassert_ok(
+        zyphal_publish_wait(&tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl1, 187, K_MSEC(10)));
+    zassert_ok(
+        zyphal_publish_wait(&tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl1, 187, K_MSEC(10)));
+    zassert_ok(zyphal_republish(&tx, K_MSEC(10), publish_done_cb, &sem));
+    zassert_ok(k_sem_take(&sem, K_FOREVER));
+    for (uint8_t transfer_id = 0; transfer_id < 3; transfer_id++) {
+        can_fff_assert_popped_frame_equal(
+            (struct can_frame){.id = 0x10723455,
+                               .dlc = 15,
+                               .data = {FILL_ARRAY(63, 0x33), 0xA0 | transfer_id}});
+        can_fff_assert_popped_frame_equal(
+            (struct can_frame){.id = 0x10723455,
+                               .dlc = 15,
+                               .data = {FILL_ARRAY(63, 0x33), 0x00 | transfer_id}});
+        can_fff_assert_popped_frame_equal((struct can_frame){
+            .id = 0x10723455,
+            .dlc = 15,
+            .data = {FILL_ARRAY(61, 0x33), 0x95, 0x90, 0x60 | transfer_id}});
+    }
+    can_fff_assert_frames_empty();
+
+    /* A changed payload is built again. */
+    uint8_t pl2[] = {FILL_ARRAY(81, 0x66)};
+    zassert_ok(
+        zyphal_publish_wait(&tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl2, 81, K_MSEC(10)));
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x66), 0xA3}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455,
+        .dlc = 12,
+        .data = {FILL_ARRAY(18, 0x66), FILL_ARRAY(3, 0), 0xDE, 0x2D, 0x43}});
+    can_fff_assert_frames_empty();
+
+    zassert_equal(zyphal_tx_cache_set(&tx, NULL, 1), -EINVAL);
+    zassert_ok(zyphal_tx_cache_set(&tx, NULL, 0));
+    zassert_equal(zyphal_republish(&tx, K_MSEC(10), publish_done_cb, &sem), -ENOENT);
+}
+
 ZTEST(transmit, priority_ordering) {
     zyphal_tx_t txs[9];
     for (size_t i = 0; i < ARRAY_SIZE(txs); i++) {
@@ -150,21 +375,74 @@ ZTEST(transmit, priority_ordering) {
 
     for (size_t i = 0; i < sem.limit; i++) { zassert_ok(k_sem_take(&sem, K_FOREVER)); }
 
+    /* Priority is not part of the session, transfer IDs follow the publish order. */
     struct can_frame expected_frames[] = {
-        {.id = 0x723455, .dlc = 2, .data = {7, 0xE0}},
-        {.id = 0x4723455, .dlc = 2, .data = {6, 0xE0}},
-        {.id = 0x8723455, .dlc = 2, .data = {5, 0xE0}},
-        {.id = 0xC723455, .dlc = 2, .data = {4, 0xE0}},
-        {.id = 0x10723455, .dlc = 2, .data = {3, 0xE0}},
-        {.id = 0x10723455, .dlc = 2, .data = {8, 0xE0}},
-        {.id = 0x14723455, .dlc = 2, .data = {2, 0xE0}},
-        {.id = 0x18723455, .dlc = 2, .data = {1, 0xE0}},
+        {.id = 0x723455, .dlc = 2, .data = {7, 0xE7}},
+        {.id = 0x4723455, .dlc = 2, .data = {6, 0xE6}},
+        {.id = 0x8723455, .dlc = 2, .data = {5, 0xE5}},
+        {.id = 0xC723455, .dlc = 2, .data = {4, 0xE4}},
+        {.id = 0x10723455, .dlc = 2, .data = {3, 0xE3}},
+        {.id = 0x10723455, .dlc = 2, .data = {8, 0xE8}},
+        {.id = 0x14723455, .dlc = 2, .data = {2, 0xE2}},
+        {.id = 0x18723455, .dlc = 2, .data = {1, 0xE1}},
         {.id = 0x1C723455, .dlc = 2, .data = {0, 0xE0}}};
     for (size_t i = 0; i < ARRAY_SIZE(expected_frames); i++) {
         can_fff_assert_popped_frame_equal(expected_frames[i]);
     }
 }
 
+static void publish_batch_done_cb(void* user_data, int32_t status) {
+    zassert_ok(status);
+    struct k_sem* sem = (struct k_sem*)user_data;
+    k_sem_give(sem);
+}
+
+ZTEST(transmit, publish_batch) {
+    zyphal_tx_t txs[2];
+    for (size_t i = 0; i < ARRAY_SIZE(txs); i++) {
+        zassert_ok(zyphal_tx_init(&inst, &txs[i]));
+    }
+
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 2));
+    zyphal_publish_batch_t batch = {0};
+
+    /* One invalid entry rejects the whole batch. */
+    uint8_t payloads[] = {0, 1};
+    zyphal_publish_entry_t entries[] = {
+        {&txs[0], ZYPHAL_PRIO_LOW, SUBJECT_ID, &payloads[0], 1, K_MSEC(10)},
+        {&txs[1], ZYPHAL_PRIO_HIGH, SUBJECT_ID, &payloads[1], 1, K_MSEC(10)},
+        {&txs[0], ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, &payloads[0], 1, K_MSEC(10)}};
+    entries[1].subject_id = ZYPHAL_MAX_SUBJECT_ID + 1;
+    zassert_equal(
+        zyphal_publish_batch(
+            &inst, entries, ARRAY_SIZE(entries), &batch, publish_batch_done_cb, &sem),
+        -EINVAL);
+    zassert_equal(entries[0].status, -ECANCELED);
+    zassert_equal(entries[1].status, -EINVAL);
+    zassert_equal(entries[2].status, -ECANCELED);
+    zassert_false(zyphal_tx_pending(&txs[0]));
+
+    /* A transmitter listed twice is only published once, the batch completes once. */
+    entries[1].subject_id = SUBJECT_ID;
+    zassert_equal(
+        zyphal_publish_batch(
+            &inst, entries, ARRAY_SIZE(entries), &batch, publish_batch_done_cb, &sem),
+        2);
+    zassert_ok(entries[0].status);
+    zassert_ok(entries[1].status);
+    zassert_equal(entries[2].status, -EALREADY);
+
+    zassert_ok(k_sem_take(&sem, K_MSEC(10)));
+    k_sleep(K_MSEC(1));
+    zassert_equal(k_sem_take(&sem, K_NO_WAIT), -EBUSY);
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x0C723455, .dlc = 2, .data = {1, 0xE1}});
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x14723455, .dlc = 2, .data = {0, 0xE0}});
+    can_fff_assert_frames_empty();
+}
+
 ZTEST(transmit, transfer_id) {
     zyphal_tx_t tx;
     zassert_ok(zyphal_tx_init(&inst, &tx));
@@ -190,6 +468,36 @@ ZTEST(transmit, transfer_id) {
     can_fff_assert_frames_empty();
 }
 
+ZTEST(transmit, shared_sessions) {
+    zyphal_tx_t txs[2];
+    for (size_t i = 0; i < ARRAY_SIZE(txs); i++) {
+        zassert_ok(zyphal_tx_init(&inst, &txs[i]));
+    }
+
+    /* Transmitters of a subject continue one sequence, also once initialized again,
+     * while another subject has its own. */
+    uint8_t pl[] = {1};
+    zassert_ok(zyphal_publish_wait(
+        &txs[0], ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, 1, K_MSEC(10)));
+    zassert_ok(zyphal_publish_wait(
+        &txs[1], ZYPHAL_PRIO_LOW, SUBJECT_ID, pl, 1, K_MSEC(10)));
+    zassert_ok(zyphal_publish_wait(
+        &txs[1], ZYPHAL_PRIO_NOMINAL, SUBJECT_ID + 1, pl, 1, K_MSEC(10)));
+    zassert_ok(zyphal_tx_init(&inst, &txs[0]));
+    zassert_ok(zyphal_publish_wait(
+        &txs[0], ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, 1, K_MSEC(10)));
+
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x10723455, .dlc = 2, .data = {1, 0xE0}});
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x14723455, .dlc = 2, .data = {1, 0xE1}});
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x10723555, .dlc = 2, .data = {1, 0xE0}});
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x10723455, .dlc = 2, .data = {1, 0xE2}});
+    can_fff_assert_frames_empty();
+}
+
 ZTEST(transmit, busy_transfer) {
     zyphal_tx_t tx;
     zassert_ok(zyphal_tx_init(&inst, &tx));
@@ -255,6 +563,486 @@ ZTEST(transmit, cancel_transfer) {
     can_fff_assert_frames_empty();
 }
 
+ZTEST(transmit, cancel_queued_transfer) {
+    zyphal_tx_t txs[3];
+    for (size_t i = 0; i < ARRAY_SIZE(txs); i++) {
+        zassert_ok(zyphal_tx_init(&inst, &txs[i]));
+    }
+
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 2));
+    struct k_sem canceled_sem;
+    zassert_ok(k_sem_init(&canceled_sem, 0, 1));
+
+    /* Cancel the middle priority transfer while all three are queued. */
+    uint8_t payloads[] = {0, 1, 2};
+    zyphal_prio_t priorities[] = {ZYPHAL_PRIO_LOW, ZYPHAL_PRIO_NOMINAL, ZYPHAL_PRIO_HIGH};
+    for (size_t i = 0; i < ARRAY_SIZE(txs); i++) {
+        zassert_ok(zyphal_publish(&txs[i],
+                                  priorities[i],
+                                  SUBJECT_ID,
+                                  &payloads[i],
+                                  1,
+                                  K_MSEC(10),
+                                  i == 1 ? publish_done_canceled_cb : publish_done_cb,
+                                  i == 1 ? &canceled_sem : &sem));
+    }
+    zassert_ok(zyphal_tx_cancel(&txs[1]));
+    zassert_equal(zyphal_tx_cancel(&txs[1]), -EALREADY);
+    zassert_ok(k_sem_take(&canceled_sem, K_FOREVER));
+
+    for (size_t i = 0; i < sem.limit; i++) { zassert_ok(k_sem_take(&sem, K_FOREVER)); }
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x0C723455, .dlc = 2, .data = {2, 0xE2}});
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x14723455, .dlc = 2, .data = {0, 0xE0}});
+    can_fff_assert_frames_empty();
+}
+
+static void publish_done_expired_cb(void* user_data, int32_t status) {
+    zassert_equal(status, -ETIMEDOUT);
+    struct k_sem* sem = (struct k_sem*)user_data;
+    k_sem_give(sem);
+}
+
+ZTEST(transmit, expire_queued_transfer) {
+    zyphal_tx_t txs[2];
+    for (size_t i = 0; i < ARRAY_SIZE(txs); i++) {
+        zassert_ok(zyphal_tx_init(&inst, &txs[i]));
+    }
+
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 1));
+    struct k_sem expired_sem;
+    zassert_ok(k_sem_init(&expired_sem, 0, 1));
+
+    /* The controller holds back the high priority transfer, so the low priority one
+     * never reaches the front of the queue before its deadline. */
+    can_fff_set_send_status(-EAGAIN);
+    uint8_t payloads[] = {0, 1};
+    zassert_ok(zyphal_publish(&txs[0],
+                              ZYPHAL_PRIO_HIGH,
+                              SUBJECT_ID,
+                              &payloads[0],
+                              1,
+                              K_MSEC(100),
+                              publish_done_cb,
+                              &sem));
+    zassert_ok(zyphal_publish(&txs[1],
+                              ZYPHAL_PRIO_LOW,
+                              SUBJECT_ID,
+                              &payloads[1],
+                              1,
+                              K_MSEC(5),
+                              publish_done_expired_cb,
+                              &expired_sem));
+    k_sleep(K_MSEC(1));
+    zassert_equal(k_sem_take(&expired_sem, K_NO_WAIT), -EBUSY);
+
+    /* Reported at its deadline, while the high priority transfer is still queued. */
+    zassert_ok(k_sem_take(&expired_sem, K_MSEC(10)));
+    zassert_false(zyphal_tx_pending(&txs[1]));
+    zassert_true(zyphal_tx_pending(&txs[0]));
+
+    can_fff_set_send_status(0);
+    zassert_ok(k_sem_take(&sem, K_MSEC(10)));
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x0C723455, .dlc = 2, .data = {0, 0xE0}});
+    can_fff_assert_frames_empty();
+
+    zyphal_tx_stats_t stats;
+    zassert_ok(zyphal_tx_stats_get(&inst, &stats));
+    zassert_equal(stats.expired, 1);
+    zassert_equal(stats.completed, 1);
+}
+
+struct isr_publish_data {
+    struct k_timer timer;
+    zyphal_tx_t txs[3];
+    struct k_sem sem;
+};
+
+static void isr_publish_expiry(struct k_timer* timer) {
+    struct isr_publish_data* data = CONTAINER_OF(timer, struct isr_publish_data, timer);
+    static uint8_t payloads[] = {0, 1, 2};
+
+    for (size_t i = 0; i < ARRAY_SIZE(data->txs); i++) {
+        zassert_ok(zyphal_publish(&data->txs[i],
+                                  ZYPHAL_PRIO_NOMINAL,
+                                  SUBJECT_ID,
+                                  &payloads[i],
+                                  1,
+                                  K_MSEC(10),
+                                  publish_done_cb,
+                                  &data->sem));
+    }
+}
+
+ZTEST(transmit, publish_from_isr) {
+    static struct isr_publish_data data;
+    for (size_t i = 0; i < ARRAY_SIZE(data.txs); i++) {
+        zassert_ok(zyphal_tx_init(&inst, &data.txs[i]));
+    }
+    zassert_ok(k_sem_init(&data.sem, 0, 3));
+
+    k_timer_init(&data.timer, isr_publish_expiry, NULL);
+    k_timer_start(&data.timer, K_MSEC(1), K_NO_WAIT);
+    for (size_t i = 0; i < data.sem.limit; i++) {
+        zassert_ok(k_sem_take(&data.sem, K_MSEC(10)));
+    }
+
+    /* Transfers with equal CAN IDs keep the order they were published in. */
+    for (uint8_t i = 0; i < ARRAY_SIZE(data.txs); i++) {
+        can_fff_assert_popped_frame_equal(
+            (struct can_frame){.id = 0x10723455, .dlc = 2, .data = {i, 0xE0 | i}});
+    }
+    can_fff_assert_frames_empty();
+}
+
+ZTEST(transmit, pipelined_frames) {
+    if (CONFIG_ZYPHAL_TX_INFLIGHT_MAX < 3) { ztest_test_skip(); }
+
+    zyphal_tx_t txs[4];
+    for (size_t i = 0; i < ARRAY_SIZE(txs); i++) {
+        zassert_ok(zyphal_tx_init(&inst, &txs[i]));
+    }
+
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 4));
+    can_fff_set_deferred_completion(true);
+
+    uint8_t pl[] = {FILL_ARRAY(187, 0x33)};
+    uint8_t payloads[] = {1, 2, 3};
+    zassert_ok(zyphal_publish(&txs[0],
+                              ZYPHAL_PRIO_NOMINAL,
+                              SUBJECT_ID,
+                              pl,
+                              sizeof(pl),
+                              K_MSEC(10),
+                              publish_done_cb,
+                              &sem));
+    zassert_ok(zyphal_publish(&txs[1],
+                              ZYPHAL_PRIO_LOW,
+                              SUBJECT_ID,
+                              &payloads[0],
+                              1,
+                              K_MSEC(10),
+                              publish_done_cb,
+                              &sem));
+    zassert_ok(zyphal_publish(&txs[2],
+                              ZYPHAL_PRIO_LOW,
+                              SUBJECT_ID + 1,
+                              &payloads[1],
+                              1,
+                              K_MSEC(10),
+                              publish_done_cb,
+                              &sem));
+    /* Same CAN ID as the multi-frame transfer, waits until it has been fully sent. */
+    zassert_ok(zyphal_publish(&txs[3],
+                              ZYPHAL_PRIO_NOMINAL,
+                              SUBJECT_ID,
+                              &payloads[2],
+                              1,
+                              K_MSEC(10),
+                              publish_done_cb,
+                              &sem));
+
+    /* Only one frame of each transfer is in flight at a time. */
+    k_sleep(K_MSEC(1));
+    zassert_equal(can_fff_deferred_count(), 3);
+    can_fff_complete_deferred(1);
+    k_sleep(K_MSEC(1));
+    zassert_equal(can_fff_deferred_count(), 3);
+    can_fff_complete_deferred(1);
+    k_sleep(K_MSEC(1));
+    zassert_equal(can_fff_deferred_count(), 2);
+    can_fff_complete_deferred(2);
+    k_sleep(K_MSEC(1));
+    zassert_equal(can_fff_deferred_count(), 1);
+    can_fff_complete_deferred(1);
+    k_sleep(K_MSEC(1));
+    zassert_equal(can_fff_deferred_count(), 1);
+    can_fff_complete_deferred(1);
+
+    for (size_t i = 0; i < sem.limit; i++) { zassert_ok(k_sem_take(&sem, K_FOREVER)); }
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0xA0}});
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x14723455, .dlc = 2, .data = {1, 0xE1}});
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x14723555, .dlc = 2, .data = {2, 0xE0}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0x00}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(61, 0x33), 0x95, 0x90, 0x60}});
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x10723455, .dlc = 2, .data = {3, 0xE2}});
+    can_fff_assert_frames_empty();
+}
+
+ZTEST(transmit, busy_controller_retry) {
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 1));
+
+    /* Mailboxes full with none of our frames in flight, only a retry can resume. */
+    can_fff_set_send_status(-EAGAIN);
+    uint8_t pl[] = {1};
+    zassert_ok(zyphal_publish(
+        &tx, ZYPHAL_PRIO_LOW, SUBJECT_ID, pl, 1, K_MSEC(100), publish_done_cb, &sem));
+    k_sleep(K_MSEC(1));
+    can_fff_set_send_status(0);
+    zassert_ok(k_sem_take(&sem, K_MSEC(10)));
+
+    zyphal_tx_stats_t stats;
+    zassert_ok(zyphal_tx_stats_get(&inst, &stats));
+    zassert_true(stats.mailbox_full > 0);
+    zassert_equal(stats.busy_retries, stats.mailbox_full);
+
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x14723455, .dlc = 2, .data = {1, 0xE0}});
+    can_fff_assert_frames_empty();
+}
+
+ZTEST(transmit, busy_controller_resume) {
+    if (CONFIG_ZYPHAL_TX_INFLIGHT_MAX < 2) { ztest_test_skip(); }
+
+    zyphal_tx_t txs[2];
+    for (size_t i = 0; i < ARRAY_SIZE(txs); i++) {
+        zassert_ok(zyphal_tx_init(&inst, &txs[i]));
+    }
+
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 2));
+    can_fff_set_deferred_completion(true);
+
+    uint8_t payloads[] = {1, 2};
+    zassert_ok(zyphal_publish(&txs[0],
+                              ZYPHAL_PRIO_LOW,
+                              SUBJECT_ID,
+                              &payloads[0],
+                              1,
+                              K_MSEC(100),
+                              publish_done_cb,
+                              &sem));
+    k_sleep(K_MSEC(1));
+
+    /* With our own frame in flight, the transmitter waits for its completion. */
+    can_fff_set_send_status(-EAGAIN);
+    zassert_ok(zyphal_publish(&txs[1],
+                              ZYPHAL_PRIO_LOW,
+                              SUBJECT_ID + 1,
+                              &payloads[1],
+                              1,
+                              K_MSEC(100),
+                              publish_done_cb,
+                              &sem));
+    k_sleep(K_MSEC(10));
+
+    zyphal_tx_stats_t stats;
+    zassert_ok(zyphal_tx_stats_get(&inst, &stats));
+    zassert_equal(stats.mailbox_full, 1);
+    zassert_equal(stats.busy_retries, 0);
+
+    can_fff_set_send_status(0);
+    can_fff_complete_deferred(1);
+    k_sleep(K_MSEC(1));
+    zassert_equal(can_fff_deferred_count(), 1);
+    can_fff_complete_deferred(1);
+
+    for (size_t i = 0; i < sem.limit; i++) { zassert_ok(k_sem_take(&sem, K_FOREVER)); }
+    zassert_ok(zyphal_tx_stats_get(&inst, &stats));
+    zassert_equal(stats.mailbox_full, 1);
+
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x14723455, .dlc = 2, .data = {1, 0xE0}});
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x14723555, .dlc = 2, .data = {2, 0xE0}});
+    can_fff_assert_frames_empty();
+}
+
+ZTEST(transmit, admission_control) {
+    zyphal_tx_t txs[2];
+    for (size_t i = 0; i < ARRAY_SIZE(txs); i++) {
+        zassert_ok(zyphal_tx_init(&inst, &txs[i]));
+    }
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 2));
+
+    /* At 10 kbit/s a full frame takes about 60 ms, and a two byte frame 10 ms. */
+    zassert_ok(zyphal_iface_bitrate_set(&inst, 0, 10000, 0));
+    uint8_t pl[] = {FILL_ARRAY(187, 0x33)};
+    zassert_equal(zyphal_publish(&txs[1],
+                                 ZYPHAL_PRIO_SLOW,
+                                 SUBJECT_ID,
+                                 pl,
+                                 sizeof(pl),
+                                 K_MSEC(100),
+                                 publish_done_cb,
+                                 &sem),
+                  -EBUSY);
+    zassert_false(zyphal_tx_pending(&txs[1]));
+
+    /* Higher priority transfers are not checked, and their queued frames delay the
+     * lower priority ones. */
+    can_fff_set_deferred_completion(true);
+    zassert_ok(zyphal_publish(&txs[0],
+                              ZYPHAL_PRIO_HIGH,
+                              SUBJECT_ID,
+                              pl,
+                              sizeof(pl),
+                              K_MSEC(100),
+                              publish_done_cb,
+                              &sem));
+    k_sleep(K_MSEC(1));
+    zassert_equal(
+        zyphal_publish(
+            &txs[1], ZYPHAL_PRIO_SLOW, SUBJECT_ID, pl, 1, K_MSEC(100), NULL, NULL),
+        -EBUSY);
+    zassert_ok(zyphal_publish(&txs[1],
+                              ZYPHAL_PRIO_SLOW,
+                              SUBJECT_ID,
+                              pl,
+                              1,
+                              K_MSEC(500),
+                              publish_done_cb,
+                              &sem));
+
+    can_fff_set_deferred_completion(false);
+    can_fff_complete_deferred(can_fff_deferred_count());
+    for (size_t i = 0; i < sem.limit; i++) { zassert_ok(k_sem_take(&sem, K_FOREVER)); }
+
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x0C723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0xA0}});
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x18723455, .dlc = 2, .data = {0x33, 0xE1}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x0C723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0x00}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x0C723455, .dlc = 15, .data = {FILL_ARRAY(61, 0x33), 0x95, 0x90, 0x60}});
+    can_fff_assert_frames_empty();
+
+    zassert_equal(zyphal_iface_bitrate_set(&inst, 1, 10000, 0), -EINVAL);
+}
+
+/* Tracing hooks, counting the events of the transmit path. */
+static size_t trace_publishes;
+static size_t trace_enqueues;
+static size_t trace_frames;
+static size_t trace_dones;
+
+void zyphal_trace_tx_publish(const zyphal_tx_t* tx) { trace_publishes++; }
+void zyphal_trace_tx_enqueue(const zyphal_iface_t* iface, const zyphal_tx_t* tx) {
+    trace_enqueues++;
+}
+void zyphal_trace_tx_frame(const zyphal_iface_t* iface,
+                           const zyphal_tx_t* tx,
+                           const struct can_frame* frame) {
+    trace_frames++;
+}
+void zyphal_trace_tx_done(const zyphal_tx_t* tx, int32_t status) { trace_dones++; }
+
+ZTEST(transmit, statistics_and_tracing) {
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+    trace_publishes = trace_enqueues = trace_frames = trace_dones = 0;
+
+    uint8_t pl[] = {FILL_ARRAY(187, 0x33)};
+    zassert_ok(
+        zyphal_publish_wait(&tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, 187, K_MSEC(10)));
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0xA0}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0x00}});
+    can_fff_assert_popped_frame_equal((struct can_frame){
+        .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(61, 0x33), 0x95, 0x90, 0x60}});
+    can_fff_assert_frames_empty();
+
+    zyphal_tx_stats_t stats;
+    zassert_ok(zyphal_tx_stats_get(&inst, &stats));
+    zassert_equal(stats.published, 1);
+    zassert_equal(stats.completed, 1);
+    zassert_equal(stats.failed + stats.expired + stats.canceled, 0);
+    zassert_equal(stats.depth, 0);
+    zassert_equal(stats.depth_max, 1);
+    zassert_equal(stats.frames, 3);
+    zassert_equal(stats.bytes, 3 * 64);
+    uint32_t samples = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(stats.latency_us); i++) {
+        samples += stats.latency_us[i];
+    }
+    zassert_equal(samples, 1);
+
+    /* A canceled transfer is counted apart, and sends nothing. */
+    struct k_sem sem;
+    zassert_ok(k_sem_init(&sem, 0, 1));
+    zassert_ok(zyphal_publish(&tx,
+                              ZYPHAL_PRIO_LOW,
+                              SUBJECT_ID,
+                              pl,
+                              1,
+                              K_MSEC(10),
+                              publish_done_canceled_cb,
+                              &sem));
+    zassert_ok(zyphal_tx_cancel(&tx));
+    zassert_ok(k_sem_take(&sem, K_FOREVER));
+    can_fff_assert_frames_empty();
+
+    zassert_ok(zyphal_tx_stats_get(&inst, &stats));
+    zassert_equal(stats.published, 2);
+    zassert_equal(stats.completed, 1);
+    zassert_equal(stats.canceled, 1);
+    zassert_equal(stats.depth, 0);
+    zassert_equal(stats.frames, 3);
+
+    zassert_equal(trace_publishes, 2);
+    zassert_equal(trace_enqueues, 2);
+    zassert_equal(trace_frames, 3);
+    zassert_equal(trace_dones, 2);
+}
+
+ZTEST(transmit, redundant_interfaces) {
+    zassert_ok(zyphal_iface_add(&inst, canbus_redundant));
+    zyphal_tx_t tx;
+    zassert_ok(zyphal_tx_init(&inst, &tx));
+
+    /* Every interface sends the full transfer, with the crc computed only once. */
+    uint8_t pl[] = {FILL_ARRAY(187, 0x33)};
+    zassert_ok(
+        zyphal_publish_wait(&tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, 187, K_MSEC(10)));
+    for (size_t i = 0; i < 2; i++) {
+        can_fff_assert_popped_frame_equal((struct can_frame){
+            .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0xA0}});
+        can_fff_assert_popped_frame_equal((struct can_frame){
+            .id = 0x10723455, .dlc = 15, .data = {FILL_ARRAY(63, 0x33), 0x00}});
+        can_fff_assert_popped_frame_equal((struct can_frame){
+            .id = 0x10723455,
+            .dlc = 15,
+            .data = {FILL_ARRAY(61, 0x33), 0x95, 0x90, 0x60}});
+    }
+    can_fff_assert_frames_empty();
+
+    /* Completing on the first interface drops the transfer from the other. */
+    zassert_ok(zyphal_tx_policy_set(&inst, ZYPHAL_TX_POLICY_FIRST));
+    zassert_ok(
+        zyphal_publish_wait(&tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, 1, K_MSEC(10)));
+    can_fff_assert_popped_frame_equal(
+        (struct can_frame){.id = 0x10723455, .dlc = 2, .data = {0x33, 0xE1}});
+    can_fff_assert_frames_empty();
+
+    /* Failures are only reported once every interface has failed. */
+    can_fff_set_send_status(-ENETDOWN);
+    zassert_equal(
+        zyphal_publish_wait(&tx, ZYPHAL_PRIO_NOMINAL, SUBJECT_ID, pl, 1, K_MSEC(10)),
+        -ENETDOWN);
+    can_fff_set_send_status(0);
+
+    zassert_equal(zyphal_iface_add(&inst, canbus_redundant), -ENOMEM);
+    zassert_equal(zyphal_tx_policy_set(&inst, ZYPHAL_TX_POLICY_FIRST + 1), -EINVAL);
+}
+
 ZTEST(transmit, errors) {
     zyphal_tx_t tx;
     zassert_ok(zyphal_tx_init(&inst, &tx));
@@ -282,6 +1070,11 @@ ZTEST(transmit, errors) {
         -ENETDOWN);
     can_fff_set_send_status(0);
 
+    /* Instances not zeroed before their first initialization. */
+    static zyphal_inst_t garbage;
+    memset(&garbage, 0xA5, sizeof(garbage));
+    zassert_equal(zyphal_init(&garbage, canbus, NODE_ID), -EINVAL);
+
     can_fff_assert_frames_empty();
 }
 